@@ -31,6 +31,7 @@ void BioGraph::load(euter::ObjectStore const& os)
 			}
 
 			m_edges.insert(edges_type::value_type(edge.first, m_edges.size()));
+			m_connectivity.emplace_back(proj_view);
 		}
 	}
 }
@@ -60,6 +61,11 @@ auto BioGraph::edge_from_id(routing::results::Edge const& id) const -> edge_desc
 	return m_edges.right.at(id.value());
 }
 
+ProjectionConnectivity const& BioGraph::connectivity(edge_descriptor const& edge) const
+{
+	return m_connectivity.at(m_edges.left.at(edge));
+}
+
 bool is_source(BioGraph::vertex_descriptor const& v, BioGraph::graph_type const& graph) {
 	return graph[v]->parameters().is_source();
 }
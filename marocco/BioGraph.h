@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 #include <boost/bimap.hpp>
 #include <boost/unordered_map.hpp>
 
@@ -30,6 +31,7 @@ class ProjectionView {};
 }
 #endif // !PYPLUSPLUS
 
+#include "marocco/ProjectionConnectivity.h"
 #include "marocco/util/iterable.h"
 #include "marocco/routing/results/Edge.h"
 
@@ -68,11 +70,20 @@ public:
 
 	edge_descriptor edge_from_id(routing::results::Edge const& id) const;
 
+	/**
+	 * @brief Return sparse connectivity of the specified projection view.
+	 * The connectivity of all projection views is extracted once in \c load(), so
+	 * weight matrices do not have to be scanned repeatedly during mapping.
+	 */
+	ProjectionConnectivity const& connectivity(edge_descriptor const& edge) const;
+
 private:
 	graph_type m_graph;
 #ifndef PYPLUSPLUS
 	edges_type m_edges;
 	vertices_type m_vertices;
+	/// Indexed by edge id, see \c edge_to_id().
+	std::vector<ProjectionConnectivity> m_connectivity;
 #endif // !PYPLUSPLUS
 }; // BioGraph
 bool is_source(BioGraph::vertex_descriptor const& v, BioGraph::graph_type const& graph);
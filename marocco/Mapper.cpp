@@ -17,6 +17,7 @@
 #include "marocco/parameter/HICANNParameters.h"
 #include "marocco/placement/Placement.h"
 #include "marocco/routing/Routing.h"
+#include "marocco/routing/results/Congestion.h"
 #include "marocco/routing/SynapseLoss.h"
 #include "marocco/util/iterable.h"
 
@@ -203,6 +204,15 @@ void Mapper::run(ObjectStore const& pynn)
 	    std::chrono::duration_cast<std::chrono::milliseconds>(endPlacement - startPlacement)
 	        .count();
 
+	{
+		auto const congestion = routing::results::Congestion::estimate(
+		    mBioGraph.graph(), m_results->placement, m_results->resources);
+		MAROCCO_INFO(
+		    "Estimated L1 bus utilization of placement: " << congestion.max_utilization()
+		    << " at most, " << congestion.num_overflowed()
+		    << " HICANN(s) and orientation(s) over capacity");
+	}
+
 	// 2.  R O U T I N G
 	auto startRouting = std::chrono::system_clock::now();
 	routing::Routing router(
@@ -0,0 +1,147 @@
+#include "marocco/ProjectionConnectivity.h"
+
+#include <cmath>
+#include <stdexcept>
+
+namespace marocco {
+
+ProjectionConnectivity::index_type const ProjectionConnectivity::invalid;
+
+ProjectionConnectivity::ProjectionConnectivity()
+	: m_row_offsets(1, 0),
+	  m_columns(),
+	  m_column_offsets(1, 0),
+	  m_rows(),
+	  m_pre_mask(),
+	  m_post_mask()
+{
+}
+
+ProjectionConnectivity::ProjectionConnectivity(euter::ProjectionView const& proj_view)
+	: ProjectionConnectivity()
+{
+	m_pre_mask = rank_select(proj_view.pre().mask());
+	m_post_mask = rank_select(proj_view.post().mask());
+
+	auto const weights = proj_view.getWeights();
+	size_t const rows = weights.size1();
+	size_t const columns = weights.size2();
+	if (rows != m_pre_mask.count() || columns != m_post_mask.count()) {
+		throw std::runtime_error("weight matrix does not match projection view");
+	}
+
+	// Single pass over the dense matrix to fill the CSR part, counting column entries
+	// on the way.
+	m_row_offsets.reserve(rows + 1);
+	std::vector<index_type> column_counts(columns, 0);
+	for (size_t ii = 0; ii < rows; ++ii) {
+		for (size_t jj = 0; jj < columns; ++jj) {
+			double const weight = weights(ii, jj);
+			if (std::isnan(weight) || weight <= 0.) {
+				continue;
+			}
+			m_columns.push_back(static_cast<index_type>(jj));
+			++column_counts[jj];
+		}
+		m_row_offsets.push_back(static_cast<index_type>(m_columns.size()));
+	}
+	m_columns.shrink_to_fit();
+
+	// Transpose into CSC.  Rows are visited in ascending order, so row indices per
+	// column end up sorted.
+	m_column_offsets.reserve(columns + 1);
+	for (size_t jj = 0; jj < columns; ++jj) {
+		m_column_offsets.push_back(m_column_offsets.back() + column_counts[jj]);
+	}
+	m_rows.resize(m_columns.size());
+	std::vector<index_type> next(m_column_offsets.begin(), m_column_offsets.end() - 1);
+	for (size_t ii = 0; ii < rows; ++ii) {
+		for (index_type const jj : row(ii)) {
+			m_rows[next[jj]++] = static_cast<index_type>(ii);
+		}
+	}
+}
+
+size_t ProjectionConnectivity::size1() const
+{
+	return m_row_offsets.size() - 1;
+}
+
+size_t ProjectionConnectivity::size2() const
+{
+	return m_column_offsets.size() - 1;
+}
+
+size_t ProjectionConnectivity::nnz() const
+{
+	return m_columns.size();
+}
+
+auto ProjectionConnectivity::slice(
+    std::vector<index_type> const& offsets, std::vector<index_type> const& indices, size_t ii)
+    -> indices_type
+{
+	if (ii + 1 >= offsets.size()) {
+		throw std::out_of_range("index out of range of projection view");
+	}
+	index_type const* const data = indices.data();
+	return indices_type(data + offsets[ii], data + offsets[ii + 1]);
+}
+
+auto ProjectionConnectivity::row(size_t pre) const -> indices_type
+{
+	return slice(m_row_offsets, m_columns, pre);
+}
+
+auto ProjectionConnectivity::column(size_t post) const -> indices_type
+{
+	return slice(m_column_offsets, m_rows, post);
+}
+
+size_t ProjectionConnectivity::row_nnz(size_t pre) const
+{
+	return m_row_offsets.at(pre + 1) - m_row_offsets.at(pre);
+}
+
+size_t ProjectionConnectivity::column_nnz(size_t post) const
+{
+	return m_column_offsets.at(post + 1) - m_column_offsets.at(post);
+}
+
+auto ProjectionConnectivity::pre_index(size_t neuron_index) const -> index_type
+{
+	if (neuron_index >= m_pre_mask.size() || !m_pre_mask.test(neuron_index)) {
+		return invalid;
+	}
+	return static_cast<index_type>(m_pre_mask.rank(neuron_index));
+}
+
+auto ProjectionConnectivity::post_index(size_t neuron_index) const -> index_type
+{
+	if (neuron_index >= m_post_mask.size() || !m_post_mask.test(neuron_index)) {
+		return invalid;
+	}
+	return static_cast<index_type>(m_post_mask.rank(neuron_index));
+}
+
+size_t ProjectionConnectivity::pre_neuron(size_t pre) const
+{
+	return m_pre_mask.select(pre);
+}
+
+size_t ProjectionConnectivity::post_neuron(size_t post) const
+{
+	return m_post_mask.select(post);
+}
+
+rank_select const& ProjectionConnectivity::pre_mask() const
+{
+	return m_pre_mask;
+}
+
+rank_select const& ProjectionConnectivity::post_mask() const
+{
+	return m_post_mask;
+}
+
+} // namespace marocco
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#ifndef PYPLUSPLUS
+#include "euter/projection_view.h"
+#else
+namespace euter {
+class ProjectionView;
+}
+#endif // !PYPLUSPLUS
+
+#include "marocco/util/iterable.h"
+#include "marocco/util/rank_select.h"
+
+namespace marocco {
+
+/**
+ * @brief Sparse connectivity of a single projection view.
+ * Stores the positions of all realized connections, i.e. entries of the weight matrix
+ * that are finite and positive, both in compressed row (CSR) and compressed column (CSC)
+ * format.  This allows to iterate over the targets of a source neuron (or the sources of
+ * a target neuron) without scanning the dense weight matrix.
+ * Rows and columns are indexed relative to the pre- and postsynaptic population views,
+ * matching the indices of \c euter::ProjectionView::getWeights().
+ * Additionally, translation between absolute neuron indices in the populations and
+ * relative indices in the projection view is provided.
+ */
+class ProjectionConnectivity
+{
+public:
+	typedef std::uint32_t index_type;
+	typedef iterable<index_type const*> indices_type;
+
+	/// Marks neuron indices not contained in the projection view.
+	static index_type const invalid = index_type(-1);
+
+	ProjectionConnectivity();
+	explicit ProjectionConnectivity(euter::ProjectionView const& proj_view);
+
+	/// Number of presynaptic neurons in the projection view.
+	size_t size1() const;
+
+	/// Number of postsynaptic neurons in the projection view.
+	size_t size2() const;
+
+	/// Total number of realized connections.
+	size_t nnz() const;
+
+	/**
+	 * @brief Relative indices of postsynaptic neurons connected to the given source.
+	 * Indices are sorted in ascending order.
+	 * @param pre Relative index of presynaptic neuron.
+	 */
+	indices_type row(size_t pre) const;
+
+	/**
+	 * @brief Relative indices of presynaptic neurons connected to the given target.
+	 * Indices are sorted in ascending order.
+	 * @param post Relative index of postsynaptic neuron.
+	 */
+	indices_type column(size_t post) const;
+
+	size_t row_nnz(size_t pre) const;
+	size_t column_nnz(size_t post) const;
+
+	/**
+	 * @brief Relative index of the given presynaptic neuron in the projection view.
+	 * @param neuron_index Absolute index of neuron in presynaptic population.
+	 * @return Relative index or \c invalid if neuron is not part of the view.
+	 */
+	index_type pre_index(size_t neuron_index) const;
+
+	/// @see pre_index()
+	index_type post_index(size_t neuron_index) const;
+
+	/// Absolute index of presynaptic neuron given its relative index in the view.
+	size_t pre_neuron(size_t pre) const;
+
+	/// Absolute index of postsynaptic neuron given its relative index in the view.
+	size_t post_neuron(size_t post) const;
+
+	/// Mask of presynaptic population view.
+	rank_select const& pre_mask() const;
+
+	/// Mask of postsynaptic population view.
+	rank_select const& post_mask() const;
+
+private:
+	static indices_type slice(
+	    std::vector<index_type> const& offsets,
+	    std::vector<index_type> const& indices,
+	    size_t ii);
+
+	/// CSR: m_row_offsets[i] .. m_row_offsets[i + 1] index into m_columns.
+	std::vector<index_type> m_row_offsets;
+	std::vector<index_type> m_columns;
+
+	/// CSC: m_column_offsets[j] .. m_column_offsets[j + 1] index into m_rows.
+	std::vector<index_type> m_column_offsets;
+	std::vector<index_type> m_rows;
+
+	rank_select m_pre_mask;
+	rank_select m_post_mask;
+}; // ProjectionConnectivity
+
+} // namespace marocco
@@ -0,0 +1,210 @@
+#include "marocco/coordinates/PackedL1Route.h"
+
+#include <stdexcept>
+#include <vector>
+#include <boost/serialization/nvp.hpp>
+#include <boost/serialization/vector.hpp>
+#include <boost/variant/static_visitor.hpp>
+
+namespace marocco {
+
+using namespace halco::hicann::v2;
+using namespace halco::common;
+
+namespace {
+
+class EnumValue : public boost::static_visitor<size_t>
+{
+public:
+	template <typename T>
+	size_t operator()(T const& coordinate) const
+	{
+		return coordinate.toEnum().value();
+	}
+}; // EnumValue
+
+} // namespace
+
+PackedL1Route::iterator::iterator() : m_it()
+{
+}
+
+PackedL1Route::iterator::iterator(sequence_type::const_iterator it) : m_it(it)
+{
+}
+
+auto PackedL1Route::iterator::tag() const -> Tag
+{
+	return PackedL1Route::tag(*m_it);
+}
+
+size_t PackedL1Route::iterator::value() const
+{
+	return PackedL1Route::value(*m_it);
+}
+
+bool PackedL1Route::iterator::equal(iterator const& other) const
+{
+	return m_it == other.m_it;
+}
+
+void PackedL1Route::iterator::increment()
+{
+	++m_it;
+}
+
+void PackedL1Route::iterator::decrement()
+{
+	--m_it;
+}
+
+void PackedL1Route::iterator::advance(std::ptrdiff_t n)
+{
+	m_it += n;
+}
+
+std::ptrdiff_t PackedL1Route::iterator::distance_to(iterator const& other) const
+{
+	return other.m_it - m_it;
+}
+
+auto PackedL1Route::iterator::dereference() const -> segment_type
+{
+	return decode(*m_it);
+}
+
+PackedL1Route::PackedL1Route() : m_words()
+{
+}
+
+PackedL1Route::PackedL1Route(L1Route const& route) : m_words()
+{
+	m_words.reserve(route.size());
+	for (auto const& segment : route) {
+		m_words.push_back(encode(segment));
+	}
+}
+
+L1Route PackedL1Route::unpack() const
+{
+	L1Route::sequence_type segments;
+	segments.reserve(m_words.size());
+	for (auto const word : m_words) {
+		segments.push_back(decode(word));
+	}
+	// Packed routes can only be created from valid routes.
+	return L1Route(std::move(segments), L1Route::no_verify_tag());
+}
+
+bool PackedL1Route::empty() const
+{
+	return m_words.empty();
+}
+
+size_t PackedL1Route::size() const
+{
+	return m_words.size();
+}
+
+auto PackedL1Route::begin() const -> iterator
+{
+	return iterator(m_words.begin());
+}
+
+auto PackedL1Route::end() const -> iterator
+{
+	return iterator(m_words.end());
+}
+
+auto PackedL1Route::operator[](size_t pos) const -> segment_type
+{
+	return decode(m_words.at(pos));
+}
+
+auto PackedL1Route::words() const -> sequence_type const&
+{
+	return m_words;
+}
+
+HICANNOnWafer PackedL1Route::source_hicann() const
+{
+	if (m_words.empty()) {
+		throw std::runtime_error("source_hicann() called on empty route");
+	}
+	return HICANNOnWafer(Enum(value(m_words.front())));
+}
+
+bool PackedL1Route::operator==(PackedL1Route const& other) const
+{
+	return m_words == other.m_words;
+}
+
+auto PackedL1Route::encode(segment_type const& segment) -> word_type
+{
+	size_t const value = boost::apply_visitor(EnumValue(), segment);
+	if (value >= (size_t(1) << (32 - tag_bits))) {
+		throw std::overflow_error("coordinate does not fit into packed L1 route segment");
+	}
+	return (word_type(value) << tag_bits) | word_type(segment.which());
+}
+
+auto PackedL1Route::decode(word_type word) -> segment_type
+{
+	Enum const value(PackedL1Route::value(word));
+	switch (tag(word)) {
+		case Tag::hicann:
+			return HICANNOnWafer(value);
+		case Tag::merger0:
+			return Merger0OnHICANN(value);
+		case Tag::merger1:
+			return Merger1OnHICANN(value);
+		case Tag::merger2:
+			return Merger2OnHICANN(value);
+		case Tag::merger3:
+			return Merger3OnHICANN(value);
+		case Tag::gbit_link:
+			return GbitLinkOnHICANN(value);
+		case Tag::dnc_merger:
+			return DNCMergerOnHICANN(value);
+		case Tag::repeater_block:
+			return RepeaterBlockOnHICANN(value);
+		case Tag::hline:
+			return HLineOnHICANN(value);
+		case Tag::vline:
+			return VLineOnHICANN(value);
+		case Tag::synapse_driver:
+			return SynapseDriverOnHICANN(value);
+		case Tag::synapse:
+			return SynapseOnHICANN(value);
+	}
+	throw std::runtime_error("invalid tag in packed L1 route segment");
+}
+
+std::ostream& operator<<(std::ostream& os, PackedL1Route const& route)
+{
+	return os << route.unpack();
+}
+
+template <typename Archiver>
+void PackedL1Route::save(Archiver& ar, unsigned int const /*version*/) const
+{
+	using namespace boost::serialization;
+	std::vector<word_type> const words(m_words.begin(), m_words.end());
+	ar << make_nvp("words", words);
+}
+
+template <typename Archiver>
+void PackedL1Route::load(Archiver& ar, unsigned int const /*version*/)
+{
+	using namespace boost::serialization;
+	std::vector<word_type> words;
+	ar >> make_nvp("words", words);
+	m_words.assign(words.begin(), words.end());
+}
+
+} // namespace marocco
+
+BOOST_CLASS_EXPORT_IMPLEMENT(::marocco::PackedL1Route)
+
+#include "boost/serialization/serialization_helper.tcc"
+EXPLICIT_INSTANTIATE_BOOST_SERIALIZE(::marocco::PackedL1Route)
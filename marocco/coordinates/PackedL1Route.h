@@ -0,0 +1,145 @@
+#pragma once
+
+#include <cstdint>
+#include <boost/container/small_vector.hpp>
+#include <boost/iterator/iterator_facade.hpp>
+#include <boost/operators.hpp>
+#include <boost/serialization/export.hpp>
+#include <boost/serialization/split_member.hpp>
+
+#include "marocco/coordinates/L1Route.h"
+
+namespace boost {
+namespace serialization {
+class access;
+} // namespace serialization
+} // namespace boost
+
+namespace marocco {
+
+/**
+ * @brief Compact encoding of a valid \c L1Route.
+ * Each segment is stored as a single 32 bit word holding the type of the segment in its
+ * lowest #tag_bits bits and the enum value of the coordinate in the remaining bits.
+ * Routes with up to #inline_capacity segments do not allocate.
+ * Segments are decoded on access, so loops over a route can dispatch on #tag() of each
+ * segment instead of visiting \c L1Route::segment_type.
+ */
+class PackedL1Route : public boost::equality_comparable<PackedL1Route>
+{
+public:
+	typedef std::uint32_t word_type;
+	typedef L1Route::segment_type segment_type;
+
+	static size_t const tag_bits = 4;
+	static size_t const inline_capacity = 8;
+
+	/// Type of a segment, in order of the alternatives of \c L1Route::segment_type.
+	enum class Tag : std::uint8_t
+	{
+		hicann,
+		merger0,
+		merger1,
+		merger2,
+		merger3,
+		gbit_link,
+		dnc_merger,
+		repeater_block,
+		hline,
+		vline,
+		synapse_driver,
+		synapse
+	};
+
+	typedef boost::container::small_vector<word_type, inline_capacity> sequence_type;
+
+	class iterator : public boost::iterator_facade<iterator,
+	                                               segment_type,
+	                                               boost::random_access_traversal_tag,
+	                                               // Return copy instead of reference:
+	                                               segment_type>
+	{
+	public:
+		iterator();
+		iterator(sequence_type::const_iterator it);
+
+		Tag tag() const;
+
+		/// Enum value of the coordinate of the current segment.
+		size_t value() const;
+
+		/**
+		 * @brief Decodes the current segment as the given coordinate type.
+		 * @pre \c tag() corresponds to \c T.
+		 */
+		template <typename T>
+		T as() const
+		{
+			return T(halco::common::Enum(value()));
+		}
+
+	private:
+		friend class boost::iterator_core_access;
+
+		bool equal(iterator const& other) const;
+		void increment();
+		void decrement();
+		void advance(std::ptrdiff_t n);
+		std::ptrdiff_t distance_to(iterator const& other) const;
+		segment_type dereference() const;
+
+		sequence_type::const_iterator m_it;
+	}; // iterator
+
+	PackedL1Route();
+	explicit PackedL1Route(L1Route const& route);
+
+	/// Restores the original route.
+	L1Route unpack() const;
+
+	bool empty() const;
+	size_t size() const;
+
+	iterator begin() const;
+	iterator end() const;
+
+	/// Returns the decoded segment at the given position.
+	segment_type operator[](size_t pos) const;
+
+	/// Returns the raw encoded segments.
+	sequence_type const& words() const;
+
+	/// Returns the \c HICANNOnWafer this route starts from.
+	halco::hicann::v2::HICANNOnWafer source_hicann() const;
+
+	bool operator==(PackedL1Route const& other) const;
+
+	static word_type encode(segment_type const& segment);
+	static segment_type decode(word_type word);
+
+	static Tag tag(word_type word)
+	{
+		return static_cast<Tag>(word & ((word_type(1) << tag_bits) - 1));
+	}
+
+	static size_t value(word_type word)
+	{
+		return word >> tag_bits;
+	}
+
+private:
+	sequence_type m_words;
+
+	friend class boost::serialization::access;
+	template <typename Archiver>
+	void save(Archiver& ar, unsigned int const /*version*/) const;
+	template <typename Archiver>
+	void load(Archiver& ar, unsigned int const /*version*/);
+	BOOST_SERIALIZATION_SPLIT_MEMBER()
+}; // PackedL1Route
+
+std::ostream& operator<<(std::ostream& os, PackedL1Route const& route);
+
+} // namespace marocco
+
+BOOST_CLASS_EXPORT_KEY(::marocco::PackedL1Route)
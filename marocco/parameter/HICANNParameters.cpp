@@ -9,7 +9,6 @@
 #include "marocco/parameter/CMVisitor.h"
 #include "marocco/parameter/NeuronVisitor.h"
 #include "marocco/parameter/SpikeInputVisitor.h"
-#include "marocco/routing/util.h"
 
 using namespace halco::hicann::v2;
 using namespace halco::common;
@@ -324,11 +323,16 @@ void HICANNParameters::synapses(synapse_row_calib_type const& calib)
 
 			auto const edge = m_bio_graph.edge_from_id(item.edge());
 			auto const& proj_view = m_bio_graph.graph()[edge];
-
-			size_t const src_neuron_in_proj_view = routing::to_relative_index(
-				proj_view.pre().mask(), item.source_neuron().neuron_index());
-			size_t const trg_neuron_in_proj_view = routing::to_relative_index(
-				proj_view.post().mask(), item.target_neuron().neuron_index());
+			auto const& connectivity = m_bio_graph.connectivity(edge);
+
+			auto const src_neuron_in_proj_view =
+				connectivity.pre_index(item.source_neuron().neuron_index());
+			auto const trg_neuron_in_proj_view =
+				connectivity.post_index(item.target_neuron().neuron_index());
+			if (src_neuron_in_proj_view == ProjectionConnectivity::invalid ||
+			    trg_neuron_in_proj_view == ProjectionConnectivity::invalid) {
+				throw std::runtime_error("synapse not contained in projection view");
+			}
 
 			double const bio_weight =
 				proj_view.getWeights()(src_neuron_in_proj_view, trg_neuron_in_proj_view);
@@ -7,7 +7,6 @@
 #include "marocco/Logger.h"
 #include "marocco/coordinates/BioNeuron.h"
 #include "marocco/placement/internal/free_functions.h"
-#include "marocco/routing/util.h"
 #include "marocco/util/spiral_ordering.h"
 #include "marocco/util/vertical_ordering.h"
 
@@ -19,6 +18,9 @@ ClusterByNeuronConnectivity::ClusterByNeuronConnectivity() {}
 
 void ClusterByNeuronConnectivity::initialise()
 {
+	// Edges may refer to a different graph than in previous runs.
+	m_relative_indices.clear();
+
 	for (auto nb_it = m_neuron_blocks->begin(); nb_it != m_neuron_blocks->end();) {
 		auto const& hicann = nb_it->toHICANNOnWafer();
 		auto it = m_state->find(hicann);
@@ -137,10 +139,11 @@ bool ClusterByNeuronConnectivity::is_connected(
 
 		euter::Connector::const_matrix_view_type const bio_weights = proj_view.getWeights();
 
+		auto const& indices = m_relative_indices.get(*m_bio_graph, edge);
 		size_t const src_neuron_in_proj_view =
-		    routing::to_relative_index(proj_view.pre().mask(), bio_src.neuron_index());
+		    routing::to_relative_index(indices.pre, bio_src.neuron_index());
 		size_t const trg_neuron_in_proj_view =
-		    routing::to_relative_index(proj_view.post().mask(), bio_tgt.neuron_index());
+		    routing::to_relative_index(indices.post, bio_tgt.neuron_index());
 
 
 		double const weight = bio_weights(src_neuron_in_proj_view, trg_neuron_in_proj_view);
@@ -6,6 +6,9 @@
 
 #include "pywrap/compat/macros.hpp"
 #include "marocco/coordinates/BioNeuron.h"
+#ifndef PYPLUSPLUS
+#include "marocco/routing/util.h"
+#endif // !PYPLUSPLUS
 
 namespace marocco {
 namespace placement {
@@ -135,6 +138,10 @@ protected:
 	 * @brief returns true if bio_src has a synapse with non zero weight to bio_tgt
 	 **/
 	virtual bool is_connected(BioNeuron const& bio_src, BioNeuron const& bio_tgt) const;
+#ifndef PYPLUSPLUS
+	// relative neuron indices of projection views used in the above function
+	mutable routing::RelativeIndexCache<graph_t> m_relative_indices;
+#endif // !PYPLUSPLUS
 
 	/**
 	 * @brief creates a vector of Bio Neurons sourcing from the requested neuron
@@ -152,6 +152,11 @@ HICANNOnWaferProperties Marocco::properties(halco::hicann::v2::HICANNOnWafer con
 			num_vertical_buses[right]};
 }
 
+routing::results::Congestion Marocco::estimate_congestion() const
+{
+	return routing::results::Congestion::estimate(bio_graph, placement, resources);
+}
+
 std::vector<L1RouteProperties> Marocco::l1_properties() const
 {
 	std::vector<L1RouteProperties> l1_route_properties_vec;
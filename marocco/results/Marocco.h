@@ -12,6 +12,7 @@
 #include "marocco/parameter/results/SpikeTimes.h"
 #include "marocco/placement/results/Placement.h"
 #include "marocco/results/Resources.h"
+#include "marocco/routing/results/Congestion.h"
 #include "marocco/routing/results/L1Routing.h"
 #include "marocco/routing/results/SynapseRouting.h"
 #include "marocco/parameter/results/Parameter.h"
@@ -80,6 +81,14 @@ public:
 	 */
 	std::vector<L1RouteProperties> l1_properties() const;
 
+	/**
+	 * @brief Estimate the L1 bus congestion of the stored placement.
+	 * This only depends on placement and available resources, so it can be used to judge
+	 * placements without running the L1 routing.
+	 * @see routing::results::Congestion::estimate()
+	 */
+	routing::results::Congestion estimate_congestion() const;
+
 private:
 	friend class boost::serialization::access;
 	template <typename Archiver>
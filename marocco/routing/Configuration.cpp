@@ -4,11 +4,17 @@
 #include <boost/variant/static_visitor.hpp>
 
 using marocco::L1Route;
+using marocco::PackedL1Route;
 using namespace halco::hicann::v2;
 using namespace halco::common;
 
 class ConfigureL1RouteVisitor : public boost::static_visitor<>
 {
+	static constexpr unsigned transition(PackedL1Route::Tag current, PackedL1Route::Tag next)
+	{
+		return (static_cast<unsigned>(current) << 8) | static_cast<unsigned>(next);
+	}
+
 	sthal::Wafer& m_hardware;
 	HICANNOnWafer m_current_hicann;
 	bool m_enable_test_data_output;
@@ -44,6 +50,47 @@ public:
 		boost::apply_visitor(*this, current, next);
 	}
 
+	/**
+	 * @brief Dispatches on the tags of packed segments instead of visiting both variants.
+	 * Only pairs of segments without a configuration of their own are decoded to fall back
+	 * to the generic overloads.
+	 */
+	void apply(PackedL1Route::iterator it, PackedL1Route::iterator const end)
+	{
+		typedef PackedL1Route::Tag Tag;
+		auto next = std::next(it);
+		for (; next != end; ++it, ++next) {
+			switch (transition(it.tag(), next.tag())) {
+				case transition(Tag::vline, Tag::hline):
+					operator()(it.as<VLineOnHICANN>(), next.as<HLineOnHICANN>());
+					break;
+				case transition(Tag::hline, Tag::vline):
+					operator()(it.as<HLineOnHICANN>(), next.as<VLineOnHICANN>());
+					break;
+				case transition(Tag::dnc_merger, Tag::hline):
+					operator()(it.as<DNCMergerOnHICANN>(), next.as<HLineOnHICANN>());
+					break;
+				case transition(Tag::dnc_merger, Tag::hicann):
+					operator()(it.as<DNCMergerOnHICANN>(), next.as<HICANNOnWafer>());
+					break;
+				case transition(Tag::repeater_block, Tag::hline):
+				case transition(Tag::repeater_block, Tag::vline):
+					m_enable_test_data_output = true;
+					break;
+				case transition(Tag::hline, Tag::hicann):
+					operator()(it.as<HLineOnHICANN>(), next.as<HICANNOnWafer>());
+					break;
+				case transition(Tag::vline, Tag::hicann):
+					operator()(it.as<VLineOnHICANN>(), next.as<HICANNOnWafer>());
+					break;
+				default:
+					if (it.tag() != Tag::hicann) {
+						apply(*it, *next);
+					}
+			}
+		}
+	}
+
 	//  ——— Crossbars ——————————————————————————————————————————————————————————
 
 	void operator()(VLineOnHICANN const& current, HLineOnHICANN const& next)
@@ -175,6 +222,12 @@ void configure(sthal::Wafer& hw, L1Route const& route)
 	visitor.apply(route.begin(), route.end());
 }
 
+void configure(sthal::Wafer& hw, PackedL1Route const& route)
+{
+	ConfigureL1RouteVisitor visitor(hw, route.source_hicann());
+	visitor.apply(route.begin(), route.end());
+}
+
 void configure(sthal::Wafer& hw, L1RouteTree const& tree, ConfigureL1RouteVisitor& visitor)
 {
 	auto const& route = tree.head();
@@ -3,6 +3,7 @@
 #include "sthal/Wafer.h"
 #include "marocco/coordinates/L1Route.h"
 #include "marocco/coordinates/L1RouteTree.h"
+#include "marocco/coordinates/PackedL1Route.h"
 
 namespace marocco {
 namespace routing {
@@ -14,6 +15,14 @@ namespace routing {
  */
 void configure(sthal::Wafer& hw, L1Route const& route);
 
+/**
+ * @brief Configure sthal container to implement a given packed L1 route.
+ * This dispatches on the tags of the packed segments and is used for the routes stored
+ * in \c results::L1Routing, which are kept in packed form.
+ * @see configure(sthal::Wafer&, L1Route const&)
+ */
+void configure(sthal::Wafer& hw, PackedL1Route const& route);
+
 /**
  * @brief Configure sthal container to implement the given L1 routes.
  * @note This does not check for configuration conflicts.
@@ -1,5 +1,10 @@
 #include "marocco/routing/HICANNRouting.h"
 
+#include <vector>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include "marocco/Logger.h"
 #include "marocco/routing/SynapseRouting.h"
 
 using namespace halco::hicann::v2;
@@ -20,6 +25,7 @@ HICANNRouting::HICANNRouting(
 	  m_resource_manager(resource_manager),
 	  m_pymarocco(pymarocco),
 	  m_neuron_placement(neuron_placement),
+	  m_index(neuron_placement),
 	  m_l1_routing(l1_routing),
 	  m_synapse_loss(synapse_loss)
 {
@@ -27,8 +33,44 @@ HICANNRouting::HICANNRouting(
 
 void HICANNRouting::run(results::SynapseRouting& result)
 {
+	if (!m_pymarocco.synapse_routing.parallel()) {
+		for (HICANNGlobal const& hicann : m_resource_manager.allocated()) {
+			run(hicann, result);
+		}
+		return;
+	}
+
+	std::vector<HICANNGlobal> hicanns;
 	for (HICANNGlobal const& hicann : m_resource_manager.allocated()) {
-		run(hicann, result);
+		if (!m_neuron_placement.find(hicann).empty()) {
+			hicanns.push_back(hicann);
+		}
+	}
+
+	MAROCCO_DEBUG("running synapse routing for " << hicanns.size() << " HICANNs in parallel");
+
+	// Chip configurations may be allocated lazily, which must not happen concurrently.
+	for (auto const& hicann : hicanns) {
+		m_hardware[hicann];
+	}
+
+	// Each HICANN writes to its own shard of the results.
+	std::vector<results::SynapseRouting> shards(hicanns.size());
+	tbb::parallel_for(
+	    tbb::blocked_range<size_t>(0, hicanns.size()),
+	    [&](tbb::blocked_range<size_t> const& range) {
+		    for (size_t ii = range.begin(); ii != range.end(); ++ii) {
+			    run(hicanns[ii], shards[ii]);
+		    }
+	    });
+
+	// Merge in order of allocation, so the result does not depend on thread scheduling.
+	for (size_t ii = 0; ii < hicanns.size(); ++ii) {
+		auto& shard = shards[ii];
+		if (shard.has(hicanns[ii])) {
+			result[hicanns[ii]] = std::move(shard[hicanns[ii]]);
+		}
+		result.synapses().merge(shard.synapses());
 	}
 }
 
@@ -45,7 +87,7 @@ void HICANNRouting::run(
 	// chip or not, because we need the synapse target mapping for param trafo
 	SynapseRouting synapse_routing(
 		hicann, m_bio_graph, m_hardware, m_resource_manager, m_pymarocco.synapse_routing,
-		m_neuron_placement, m_l1_routing, m_synapse_loss, result);
+		m_neuron_placement, m_index, m_l1_routing, m_synapse_loss, result);
 	synapse_routing.run();
 }
 
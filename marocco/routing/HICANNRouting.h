@@ -6,6 +6,7 @@
 #include "marocco/BioGraph.h"
 #include "marocco/placement/results/Placement.h"
 #include "marocco/routing/L1RoutingGraph.h"
+#include "marocco/routing/SynapseRoutingIndex.h"
 #include "marocco/routing/SynapseRowSource.h"
 #include "marocco/routing/results/SynapseRouting.h"
 #include "marocco/routing/results/L1Routing.h"
@@ -30,6 +31,10 @@ public:
 		results::L1Routing const& l1_routing,
 		boost::shared_ptr<SynapseLoss> const& synapse_loss);
 
+	/**
+	 * @brief Runs synapse routing for all allocated HICANNs.
+	 * @see parameters::SynapseRouting::parallel()
+	 */
 	void run(results::SynapseRouting& result);
 
 private:
@@ -40,6 +45,7 @@ private:
 	resource_manager_t& m_resource_manager;
 	pymarocco::PyMarocco const& m_pymarocco;
 	placement::results::Placement const& m_neuron_placement;
+	SynapseRoutingIndex const m_index;
 	results::L1Routing const& m_l1_routing;
 	boost::shared_ptr<SynapseLoss> m_synapse_loss;
 };
@@ -1,7 +1,6 @@
 #include "marocco/routing/HandleSynapseLoss.h"
 
 #include "marocco/routing/SynapseLoss.h"
-#include "marocco/routing/util.h"
 
 using namespace halco::hicann::v2;
 
@@ -41,6 +40,7 @@ void HandleSynapseLoss::operator()(
 	auto const source = boost::source(projection, m_bio_graph.graph());
 	auto const target = boost::target(projection, m_bio_graph.graph());
 	auto const& proj_view = m_bio_graph.graph()[projection];
+	auto const& connectivity = m_bio_graph.connectivity(projection);
 	Connector::const_matrix_view_type const bio_weights = proj_view.getWeights();
 
 	SynapseLossProxy syn_loss_proxy =
@@ -54,13 +54,11 @@ void HandleSynapseLoss::operator()(
 			continue;
 		}
 
-		if (!proj_view.post().mask()[target_item.neuron_index()]) {
+		auto const trg_neuron_in_proj_view = connectivity.post_index(target_item.neuron_index());
+		if (trg_neuron_in_proj_view == ProjectionConnectivity::invalid) {
 			continue;
 		}
 
-		size_t const trg_neuron_in_proj_view = to_relative_index(
-			proj_view.post().mask(), target_item.neuron_index());
-
 		for (auto const& source_item : m_neuron_placement.find(source)) {
 			auto const& address = source_item.address();
 			// Only process source neuron placements matching current route.
@@ -69,13 +67,12 @@ void HandleSynapseLoss::operator()(
 				continue;
 			}
 
-			if (!proj_view.pre().mask()[source_item.neuron_index()]) {
+			auto const src_neuron_in_proj_view =
+				connectivity.pre_index(source_item.neuron_index());
+			if (src_neuron_in_proj_view == ProjectionConnectivity::invalid) {
 				continue;
 			}
 
-			size_t const src_neuron_in_proj_view = to_relative_index(
-				proj_view.pre().mask(), source_item.neuron_index());
-
 			double const weight =
 				bio_weights(src_neuron_in_proj_view, trg_neuron_in_proj_view);
 
@@ -12,11 +12,14 @@ L1BackboneRouter::L1BackboneRouter(
     L1GraphWalker const& walker,
     vertex_descriptor const& source,
     score_function_type const& vertical_scoring,
-    boost::optional<resource::HICANNManager&> resource_manager) :
+    boost::optional<resource::HICANNManager&> resource_manager,
+    boost::optional<RoutingWorkspace&> workspace) :
     m_walker(walker),
     m_graph(walker.graph()),
     m_source(source),
     m_vertical_scoring(vertical_scoring),
+    m_own_workspace(workspace ? nullptr : new RoutingWorkspace()),
+    m_workspace(workspace ? *workspace : *m_own_workspace),
     m_res_mgr(resource_manager)
 {
 	if (!m_graph[m_source].is_horizontal()) {
@@ -32,10 +35,10 @@ void L1BackboneRouter::add_target(target_type const& target)
 PathBundle::path_type L1BackboneRouter::path_to(target_type const& target) const
 {
 	auto it = m_vertex_for_targets.find(target);
-	if (m_predecessors.empty() || it == m_vertex_for_targets.end()) {
+	if (it == m_vertex_for_targets.end()) {
 		return {};
 	}
-	return path_from_predecessors(m_predecessors, it->second);
+	return path_from_predecessors(m_workspace, it->second);
 }
 
 auto L1BackboneRouter::source() const -> vertex_descriptor
@@ -45,8 +48,7 @@ auto L1BackboneRouter::source() const -> vertex_descriptor
 
 void L1BackboneRouter::run()
 {
-	m_predecessors = std::vector<vertex_descriptor>(boost::num_vertices(m_graph));
-	std::iota(m_predecessors.begin(), m_predecessors.end(), 0);
+	m_workspace.reset(boost::num_vertices(m_graph));
 
 	// Walk horizontally until we reach the leftmost/rightmost HICANN.
 	for (auto const direction : {east, west}) {
@@ -69,7 +71,7 @@ void L1BackboneRouter::run()
 			    "Could not reach " << direction << "ernmost HICANN.\nTrying to detour from "
 			                       << m_graph[detour_start]);
 			std::tie(detour, reached_limit) =
-			    m_walker.detour_and_walk(detour_start, direction, limit, m_predecessors);
+			    m_walker.detour_and_walk(detour_start, direction, limit, m_workspace);
 			// L1GraphWalker::detour_and_walk guarantees that the detour advances
 			// horizontally by at least one HICANN, if it is not empty.
 			if (detour.empty()) {
@@ -86,10 +88,10 @@ void L1BackboneRouter::run()
 		for (auto const& vertex : path) {
 			// store predecessors to get a clear path, sometimes it happenes, that multiple
 			// crossbars are used after detours
-			m_predecessors[vertex] = predecessor;
+			m_workspace.set_predecessor(vertex, predecessor);
 			predecessor = vertex;
 		}
-		m_predecessors[m_source] = m_source;
+		m_workspace.set_predecessor(m_source, m_source);
 
 		for (auto const& vertex : path) {
 			auto hicann = m_graph[vertex].toHICANNOnWafer();
@@ -103,14 +105,14 @@ void L1BackboneRouter::run()
 		predecessor = m_source;
 		for (auto const& vertex : path) {
 			// store predecessors to get a clear path, sometimes it happened, that there were cycles
-			m_predecessors[vertex] = predecessor;
+			m_workspace.set_predecessor(vertex, predecessor);
 			predecessor = vertex;
 		}
-		m_predecessors[m_source] = m_source;
+		m_workspace.set_predecessor(m_source, m_source);
 	}
 
 	maybe_branch_off_to_vertical_targets(m_source);
-	m_predecessors[m_source] = m_source;
+	m_workspace.set_predecessor(m_source, m_source);
 }
 
 void L1BackboneRouter::maybe_branch_off_to_vertical_targets(vertex_descriptor const& vertex)
@@ -137,7 +139,7 @@ void L1BackboneRouter::maybe_branch_off_to_vertical_targets(vertex_descriptor co
 	}
 
 	candidates =
-	    L1_crossbar_restrictioning(vertex, candidates, m_predecessors, m_res_mgr, m_walker.graph());
+	    L1_crossbar_restrictioning(vertex, candidates, m_workspace, m_res_mgr, m_walker.graph());
 
 	// To establish a connection to vertical targets we consider all connected vertical buses
 	// then discard buses we are not allowed to use
@@ -188,7 +190,7 @@ void L1BackboneRouter::maybe_branch_off_to_vertical_targets(vertex_descriptor co
 		// Store predecessors and vertices for targets.
 		vertex_descriptor predecessor = vertex;
 		for (vertex_descriptor const other : path) {
-			m_predecessors[other] = predecessor;
+			m_workspace.set_predecessor(other, predecessor);
 			predecessor = other;
 
 			auto const hicann = m_graph[other].toHICANNOnWafer();
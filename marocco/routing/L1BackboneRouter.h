@@ -2,6 +2,7 @@
 
 #include <functional>
 #include <map>
+#include <memory>
 #include <unordered_map>
 
 #include <boost/optional.hpp>
@@ -12,6 +13,7 @@
 #include "marocco/routing/L1Routing.h"
 #include "marocco/routing/L1RoutingGraph.h"
 #include "marocco/routing/PathBundle.h"
+#include "marocco/routing/RoutingWorkspace.h"
 
 namespace marocco {
 namespace routing {
@@ -44,12 +46,17 @@ public:
 	 *                         score.  When selecting the starting vertical bus for a
 	 *                         vertical rib, the one that leads to the highest score will
 	 *                         win.
+	 * @param workspace Used to store the predecessors of the search.  Can be shared
+	 *                  between consecutive routers to avoid allocations; results of
+	 *                  #path_to() are only valid until the workspace is used again.  If not
+	 *                  given, a workspace owned by this router is used.
 	 */
 	L1BackboneRouter(
 	    L1GraphWalker const& walker,
 	    vertex_descriptor const& source,
 	    score_function_type const& vertical_scoring = nullptr,
-	    boost::optional<resource::HICANNManager&> resource_manager = boost::none);
+	    boost::optional<resource::HICANNManager&> resource_manager = boost::none,
+	    boost::optional<RoutingWorkspace&> workspace = boost::none);
 
 	/**
 	 * @brief Adds target requirement.
@@ -111,10 +118,12 @@ private:
 	 */
 	std::unordered_map<target_type, vertex_descriptor> m_vertex_for_targets;
 
+	std::unique_ptr<RoutingWorkspace> m_own_workspace;
+
 	/**
-	 * @brief Predecessor map used to store the path to each target vertex.
+	 * @brief Stores the predecessors used to recover the path to each target vertex.
 	 */
-	std::vector<vertex_descriptor> m_predecessors;
+	RoutingWorkspace& m_workspace;
 
 	boost::optional<resource::HICANNManager&> m_res_mgr;
 }; // L1BackboneRouter
@@ -45,7 +45,7 @@ public:
 	bool operator==(L1BusOnWafer const& other) const;
 
 	/**
-	 * @note This will be used by \c add_vertex().
+	 * @note This is required for the vertex storage of \c L1RoutingGraph.
 	 */
 	L1BusOnWafer();
 
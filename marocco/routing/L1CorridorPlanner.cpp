@@ -0,0 +1,196 @@
+#include "marocco/routing/L1CorridorPlanner.h"
+
+#include <functional>
+#include <limits>
+#include <queue>
+#include <stdexcept>
+
+#include "halco/common/iter_all.h"
+#include "marocco/util/iterable.h"
+
+using namespace halco::hicann::v2;
+using namespace halco::common;
+
+namespace marocco {
+namespace routing {
+
+namespace {
+
+/// Cost of edges whose capacity has been used up by previous corridors.
+double const exhausted_cost = 1000.;
+
+} // namespace
+
+L1CorridorPlanner::L1CorridorPlanner(L1RoutingGraph const& graph, size_t margin)
+    : m_graph(graph), m_margin(margin)
+{
+	for (auto const hicann : iter_all<HICANNOnWafer>()) {
+		if (!m_graph.has(hicann)) {
+			continue;
+		}
+		m_index.emplace(hicann, m_nodes.size());
+		m_nodes.push_back(hicann);
+	}
+	m_adjacency.resize(m_nodes.size());
+
+	for (size_t lhs = 0; lhs < m_nodes.size(); ++lhs) {
+		for (auto conv : {&HICANNOnWafer::east, &HICANNOnWafer::south}) {
+			try {
+				auto const it = m_index.find((m_nodes[lhs].*conv)());
+				if (it != m_index.end()) {
+					connect(lhs, it->second);
+				}
+			} catch (std::overflow_error const&) {
+				// reached bound of wafer, other HICANN does not exist
+			} catch (std::domain_error const&) {
+				// invalid combination of X and Y (can happen because wafer is round)
+			}
+		}
+	}
+}
+
+void L1CorridorPlanner::connect(size_t lhs, size_t rhs)
+{
+	Edge edge;
+	edge.lhs = lhs;
+	edge.rhs = rhs;
+	edge.capacity = capacity(m_nodes[lhs], m_nodes[rhs]);
+	edge.usage = 0;
+
+	m_adjacency[lhs].emplace_back(rhs, m_edges.size());
+	m_adjacency[rhs].emplace_back(lhs, m_edges.size());
+	m_edges.push_back(edge);
+}
+
+size_t L1CorridorPlanner::capacity(HICANNOnWafer const& lhs, HICANNOnWafer const& rhs) const
+{
+	if (!m_graph.has(lhs) || !m_graph.has(rhs)) {
+		return 0;
+	}
+
+	size_t const per_hicann = L1RoutingGraph::HICANN::num_vertices;
+	auto const& graph = m_graph.graph();
+	auto const first = m_graph[lhs][HLineOnHICANN(0)];
+	auto const other = m_graph[rhs][HLineOnHICANN(0)] / per_hicann;
+
+	size_t count = 0;
+	for (size_t vertex = first; vertex < first + per_hicann; ++vertex) {
+		for (auto const edge : make_iterable(boost::out_edges(vertex, graph))) {
+			if (boost::target(edge, graph) / per_hicann == other) {
+				++count;
+			}
+		}
+	}
+	return count;
+}
+
+size_t L1CorridorPlanner::margin() const
+{
+	return m_margin;
+}
+
+double L1CorridorPlanner::cost(Edge const& edge) const
+{
+	if (edge.usage >= edge.capacity) {
+		return exhausted_cost;
+	}
+	return 1. + double(edge.usage) / double(edge.capacity - edge.usage);
+}
+
+RoutingRegion L1CorridorPlanner::plan(
+    HICANNOnWafer const& source, std::vector<HICANNOnWafer> const& targets)
+{
+	RoutingRegion region(m_graph);
+	auto const source_it = m_index.find(source);
+	if (source_it == m_index.end()) {
+		return region;
+	}
+
+	size_t const none = std::numeric_limits<size_t>::max();
+	std::vector<bool> in_tree(m_nodes.size(), false);
+	std::vector<size_t> tree{source_it->second};
+	in_tree[source_it->second] = true;
+
+	std::vector<double> distance(m_nodes.size());
+	std::vector<size_t> predecessor(m_nodes.size());
+	typedef std::pair<double, size_t> entry_type;
+
+	for (auto const& target : targets) {
+		auto const target_it = m_index.find(target);
+		if (target_it == m_index.end() || in_tree[target_it->second]) {
+			continue;
+		}
+
+		// Shortest path from any node of the current tree to the target.
+		std::fill(distance.begin(), distance.end(), std::numeric_limits<double>::infinity());
+		std::fill(predecessor.begin(), predecessor.end(), none);
+		std::priority_queue<entry_type, std::vector<entry_type>, std::greater<entry_type> >
+		    queue;
+		for (auto const node : tree) {
+			distance[node] = 0.;
+			queue.emplace(0., node);
+		}
+
+		while (!queue.empty()) {
+			auto const current = queue.top();
+			queue.pop();
+			if (current.first > distance[current.second]) {
+				continue;
+			}
+			if (current.second == target_it->second) {
+				break;
+			}
+			for (auto const& adjacent : m_adjacency[current.second]) {
+				Edge const& edge = m_edges[adjacent.second];
+				if (edge.capacity == 0) {
+					continue;
+				}
+				double const candidate = current.first + cost(edge);
+				if (candidate < distance[adjacent.first]) {
+					distance[adjacent.first] = candidate;
+					predecessor[adjacent.first] = adjacent.second;
+					queue.emplace(candidate, adjacent.first);
+				}
+			}
+		}
+
+		if (distance[target_it->second] == std::numeric_limits<double>::infinity()) {
+			continue;
+		}
+
+		// Attach path to tree and reserve capacity.
+		for (size_t node = target_it->second; !in_tree[node];) {
+			in_tree[node] = true;
+			tree.push_back(node);
+			Edge& edge = m_edges[predecessor[node]];
+			++edge.usage;
+			node = edge.lhs == node ? edge.rhs : edge.lhs;
+		}
+	}
+
+	// Widen corridor by breadth-first search on the HICANN grid.
+	std::vector<bool> visited(in_tree);
+	std::vector<size_t> frontier(tree);
+	for (auto const node : tree) {
+		region.add(m_nodes[node]);
+	}
+	for (size_t step = 0; step < m_margin && !frontier.empty(); ++step) {
+		std::vector<size_t> next;
+		for (auto const node : frontier) {
+			for (auto const& adjacent : m_adjacency[node]) {
+				if (visited[adjacent.first]) {
+					continue;
+				}
+				visited[adjacent.first] = true;
+				region.add(m_nodes[adjacent.first]);
+				next.push_back(adjacent.first);
+			}
+		}
+		frontier.swap(next);
+	}
+
+	return region;
+}
+
+} // namespace routing
+} // namespace marocco
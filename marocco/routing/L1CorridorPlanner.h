@@ -0,0 +1,78 @@
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+#include "halco/hicann/v2/hicann.h"
+#include "marocco/routing/L1RoutingGraph.h"
+#include "marocco/routing/RoutingRegion.h"
+
+namespace marocco {
+namespace routing {
+
+/**
+ * @brief Plans the HICANN corridors of L1 routes on the coarse grid of HICANNs.
+ * Adjacent HICANNs are connected by coarse edges, whose capacity is the number of
+ * repeaters connecting free buses of both HICANNs.  Corridors of consecutive sources are
+ * planned against the capacity that is left, so that congested connections become
+ * increasingly expensive and sources spread over the wafer.
+ * The detailed routing of each source can then be restricted to its corridor, which
+ * avoids exploring the whole routing graph for every source.
+ */
+class L1CorridorPlanner
+{
+public:
+	/**
+	 * @param margin Number of steps on the HICANN grid by which corridors are widened
+	 *               around the HICANNs of the coarse route tree.
+	 */
+	L1CorridorPlanner(L1RoutingGraph const& graph, size_t margin);
+
+	/**
+	 * @brief Plans the corridor of a single source and reserves its capacity.
+	 * Targets are attached one after another to the nearest HICANN of the coarse route
+	 * tree.  Targets that cannot be reached on the coarse grid are left out.
+	 * @return All HICANNs of the coarse route tree and all HICANNs within #margin steps.
+	 */
+	RoutingRegion plan(
+	    halco::hicann::v2::HICANNOnWafer const& source,
+	    std::vector<halco::hicann::v2::HICANNOnWafer> const& targets);
+
+	/**
+	 * @brief Returns the number of repeaters connecting free buses of the given HICANNs.
+	 * @return Zero if the HICANNs are not adjacent.
+	 */
+	size_t capacity(
+	    halco::hicann::v2::HICANNOnWafer const& lhs,
+	    halco::hicann::v2::HICANNOnWafer const& rhs) const;
+
+	size_t margin() const;
+
+private:
+	struct Edge
+	{
+		size_t lhs;
+		size_t rhs;
+		size_t capacity;
+		/// Number of planned corridors using this edge.
+		size_t usage;
+	}; // Edge
+
+	/**
+	 * @brief Cost of using the given edge for another corridor.
+	 */
+	double cost(Edge const& edge) const;
+
+	void connect(size_t lhs, size_t rhs);
+
+	L1RoutingGraph const& m_graph;
+	size_t m_margin;
+	std::vector<halco::hicann::v2::HICANNOnWafer> m_nodes;
+	std::unordered_map<halco::hicann::v2::HICANNOnWafer, size_t> m_index;
+	std::vector<Edge> m_edges;
+	/// Adjacent nodes of each node together with the connecting edge.
+	std::vector<std::vector<std::pair<size_t, size_t> > > m_adjacency;
+}; // L1CorridorPlanner
+
+} // namespace routing
+} // namespace marocco
@@ -2,12 +2,9 @@
 
 #include <algorithm>
 #include <vector>
-#include <boost/graph/dijkstra_shortest_paths.hpp>
-#include <boost/property_map/property_map.hpp>
 
-#include "marocco/util/event_visitor.h"
-#include "marocco/util/function_property_map.h"
-#include "marocco/util/to_function.h"
+#include "marocco/util/iterable.h"
+#include "marocco/util/radix_heap.h"
 
 namespace marocco {
 namespace routing {
@@ -15,12 +12,21 @@ namespace routing {
 L1DijkstraRouter::L1DijkstraRouter(
     L1EdgeWeights const& weights,
     vertex_descriptor const& source,
-    SwitchExclusiveness exclusiveness)
+    SwitchExclusiveness exclusiveness,
+    Termination termination,
+    boost::optional<RoutingWorkspace&> workspace)
     : m_weights(weights)
     , m_graph(weights.graph())
     , m_source(source)
     , m_exclusiveness(exclusiveness)
+    , m_termination(termination)
     , m_targets()
+    , m_unreached_targets(0)
+    , m_region(nullptr)
+    , m_own_workspace(workspace ? nullptr : new RoutingWorkspace())
+    , m_workspace(workspace ? *workspace : *m_own_workspace)
+    , m_searched(false)
+    , m_rollback()
 {}
 
 void L1DijkstraRouter::add_target(target_type const& target)
@@ -28,33 +34,100 @@ void L1DijkstraRouter::add_target(target_type const& target)
 	m_targets.insert(std::make_pair(target, target_vertices_type()));
 }
 
+void L1DijkstraRouter::restrict_to(RoutingRegion const& region)
+{
+	m_region = &region;
+}
+
 void L1DijkstraRouter::run()
 {
 	if (m_targets.empty()) {
 		return;
 	}
 
-	using namespace std::placeholders;
-
-	// num_vertices() is 122 880 for a wafer with all HICANNs.
-	// sizeof(vertex_descriptor) =~ 4 byte ⇒ ~0.5 MiB (not much!)
-	m_predecessors = std::vector<vertex_descriptor>(boost::num_vertices(m_graph));
-	std::iota(m_predecessors.begin(), m_predecessors.end(), 0);
-
-	auto visitor = boost::make_dijkstra_visitor(
-		make_event_visitor(
-			to_function(&L1DijkstraRouter::finish_vertex, this, _1, _2),
-			boost::on_finish_vertex()));
-	auto weight_map =
-		make_function_property_map(to_function(&L1EdgeWeights::weight, &m_weights, _1));
-
-	boost::dijkstra_shortest_paths(
-		m_graph, m_source,
-		boost::weight_map(weight_map)
-		.predecessor_map(
-			boost::make_iterator_property_map(
-				m_predecessors.begin(), get(boost::vertex_index, m_graph)))
-		.visitor(visitor));
+	typedef RoutingWorkspace::distance_type distance_type;
+
+	// num_vertices() is 122 880 for a wafer with all HICANNs.  The workspace is only
+	// allocated once and reset in constant time for each source.
+	m_workspace.reset(boost::num_vertices(m_graph));
+	m_searched = true;
+
+	m_unreached_targets = 0;
+	for (auto const& item : m_targets) {
+		if (item.second.empty()) {
+			++m_unreached_targets;
+		}
+	}
+
+	// Single targets are searched for using A*, guided by a lower bound on the remaining
+	// distance.  Each connection between adjacent HICANNs (repeater) and each change of
+	// orientation (crossbar switch) costs at least the minimal edge weight.  This bound
+	// is consistent, so keys are still extracted in monotone order and the first
+	// candidates found for the target are as near as with plain Dijkstra.
+	bool const guided = m_termination == Termination::all_targets_reached &&
+	                    m_targets.size() == 1 && m_unreached_targets == 1;
+	auto const target_hicann = m_targets.begin()->first.toHICANNOnWafer();
+	auto const target_orientation = m_targets.begin()->first.toOrientation();
+	size_t const target_x = target_hicann.x();
+	size_t const target_y = target_hicann.y();
+	distance_type const min_weight = guided ? m_weights.min_weight() : 0;
+	auto const estimate = [&](vertex_descriptor const vertex) -> distance_type {
+		if (!guided) {
+			return 0;
+		}
+		auto const& bus = m_graph[vertex];
+		auto const hicann = bus.toHICANNOnWafer();
+		size_t const x = hicann.x();
+		size_t const y = hicann.y();
+		size_t const hops = (x > target_x ? x - target_x : target_x - x) +
+		                    (y > target_y ? y - target_y : target_y - y) +
+		                    (bus.toOrientation() == target_orientation ? 0 : 1);
+		return hops * min_weight;
+	};
+
+	// Vertices with a key larger than this are not finished anymore.
+	distance_type horizon = RoutingWorkspace::infinite_distance();
+
+	// Keys are distances plus estimated remaining distances (zero for plain Dijkstra).
+	radix_heap<distance_type, vertex_descriptor> queue;
+	m_workspace.set_distance(m_source, 0);
+	queue.push(estimate(m_source), m_source);
+
+	while (!queue.empty()) {
+		distance_type const key = queue.top().first;
+		vertex_descriptor const vertex = queue.top().second;
+		queue.pop();
+
+		// Vertices are queued again instead of decreasing their key, skip stale entries.
+		if (m_workspace.is_finished(vertex)) {
+			continue;
+		}
+		if (key > horizon) {
+			break;
+		}
+		m_workspace.set_finished(vertex);
+		distance_type const distance = m_workspace.distance(vertex);
+
+		for (auto const& edge : make_iterable(boost::out_edges(vertex, m_graph))) {
+			auto const target = boost::target(edge, m_graph);
+			if (m_workspace.is_finished(target) || (m_region && !m_region->contains(target))) {
+				continue;
+			}
+			distance_type const candidate = distance + m_weights.weight(edge);
+			if (candidate < m_workspace.distance(target)) {
+				m_workspace.set_distance(target, candidate);
+				m_workspace.set_predecessor(target, vertex);
+				queue.push(candidate + estimate(target), target);
+			}
+		}
+
+		finish_vertex(vertex, m_graph);
+
+		if (m_termination == Termination::all_targets_reached && m_unreached_targets == 0 &&
+		    horizon == RoutingWorkspace::infinite_distance()) {
+			horizon = key;
+		}
+	}
 }
 
 auto L1DijkstraRouter::vertices_for(target_type const& target) const -> target_vertices_type const&
@@ -68,10 +141,10 @@ auto L1DijkstraRouter::vertices_for(target_type const& target) const -> target_v
 
 PathBundle::path_type L1DijkstraRouter::path_to(vertex_descriptor const& target) const
 {
-	if (m_predecessors.empty()) {
+	if (!m_searched) {
 		return {};
 	}
-	return path_from_predecessors(m_predecessors, target);
+	return path_from_predecessors(m_workspace, target);
 }
 
 void L1DijkstraRouter::finish_vertex(vertex_descriptor const& vertex, graph_type const& graph)
@@ -94,19 +167,23 @@ void L1DijkstraRouter::finish_vertex(vertex_descriptor const& vertex, graph_type
 
 	switch (m_exclusiveness) {
 		case SwitchExclusiveness::per_route:
-			// Switch constraints are only considered on a per-target / per-route basis.
-			m_used_switches.clear();
-			break;
 		case SwitchExclusiveness::global:
 			break;
 		default:
 			throw std::runtime_error("unknown switch exclusiveness");
 	}
 
-	std::vector<vertex_descriptor> rollback;
+	auto& switches = m_workspace.switches();
+	auto const rollback = [this, &switches]() {
+		for (size_t ii = 0; ii < m_rollback.size(); ii += 2) {
+			switches.release(m_rollback[ii], m_rollback[ii + 1]);
+		}
+	};
+
+	m_rollback.clear();
 	auto current = vertex;
 	while (true) {
-		auto previous = m_predecessors[current];
+		auto previous = m_workspace.predecessor(current);
 
 		auto const current_bus_is_vertical = m_graph[current].is_vertical();
 		auto const previous_bus_is_vertical = m_graph[previous].is_vertical();
@@ -114,26 +191,13 @@ void L1DijkstraRouter::finish_vertex(vertex_descriptor const& vertex, graph_type
 		if (current_bus_is_vertical ^ previous_bus_is_vertical) {
 			auto const vertical = current_bus_is_vertical ? current : previous;
 			auto const horizontal = current_bus_is_vertical ? previous : current;
-			auto ret_h = m_used_switches.insert(std::make_pair(horizontal, vertical));
-			auto ret_v = m_used_switches.insert(std::make_pair(vertical, horizontal));
-			if (ret_h.second && ret_v.second) {
-				rollback.push_back(horizontal);
-				rollback.push_back(vertical);
+			if (switches.use(horizontal, vertical)) {
+				m_rollback.push_back(horizontal);
+				m_rollback.push_back(vertical);
 			} else {
 				// Switch is already in use ⇒ rollback changes and discard target.
-
-				switch (m_exclusiveness) {
-					case SwitchExclusiveness::global:
-						for (auto const& vtx : rollback) {
-							m_used_switches.erase(vtx);
-						}
-						return;
-					case SwitchExclusiveness::per_route:
-						// not necessary to rollback changes
-						return;
-					default:
-						throw std::runtime_error("unknown switch exclusiveness");
-				}
+				rollback();
+				return;
 			}
 		}
 
@@ -144,6 +208,14 @@ void L1DijkstraRouter::finish_vertex(vertex_descriptor const& vertex, graph_type
 		current = previous;
 	}
 
+	if (m_exclusiveness == SwitchExclusiveness::per_route) {
+		// Switch constraints are only considered on a per-target / per-route basis.
+		rollback();
+	}
+
+	if (it->second.empty()) {
+		--m_unreached_targets;
+	}
 	it->second.insert(vertex);
 }
 
@@ -1,13 +1,16 @@
 #pragma once
 
 #include <functional>
+#include <memory>
 #include <unordered_map>
 #include <unordered_set>
-#include <boost/property_map/property_map.hpp>
+#include <boost/optional.hpp>
 
 #include "marocco/routing/PathBundle.h"
 #include "marocco/routing/L1RoutingGraph.h"
 #include "marocco/routing/L1EdgeWeights.h"
+#include "marocco/routing/RoutingRegion.h"
+#include "marocco/routing/RoutingWorkspace.h"
 #include "marocco/routing/Target.h"
 
 namespace marocco {
@@ -34,16 +37,34 @@ public:
 		per_route
 	};
 
+	enum class Termination
+	{
+		/**
+		 * @brief Stop once every target has been reached.
+		 * All vertices with the same distance as the last target vertex are still
+		 * finished, so that all equally near candidates are found.
+		 */
+		all_targets_reached,
+		/// Explore the whole graph, i.e. find all candidates for every target.
+		exhaustive
+	};
+
 	/**
  	 * @param weights Used to calculate egde weights to use in Dijkstra's algorithm.  A
  	 *               reference to the graph this algorithm operates on is extracted from
  	 *               this parameter.
  	 * @param source Vertex corresponding to the bus the route should start from.
+	 * @param workspace Used to store predecessors and distances of the search.  Can be
+	 *                  shared between consecutive routers to avoid allocations; results of
+	 *                  #path_to() are only valid until the workspace is used again.  If not
+	 *                  given, a workspace owned by this router is used.
 	 */
 	L1DijkstraRouter(
 	    L1EdgeWeights const& weights,
 	    vertex_descriptor const& source,
-	    SwitchExclusiveness exclusiveness = SwitchExclusiveness::global);
+	    SwitchExclusiveness exclusiveness = SwitchExclusiveness::global,
+	    Termination termination = Termination::all_targets_reached,
+	    boost::optional<RoutingWorkspace&> workspace = boost::none);
 
 	/**
 	 * @brief Adds target requirement.
@@ -52,8 +73,21 @@ public:
 	 */
 	void add_target(target_type const& target);
 
+	/**
+	 * @brief Restricts the search to buses of HICANNs in the given region.
+	 * The source vertex is always part of the search.
+	 * @note The region has to outlive the call to \c run().
+	 */
+	void restrict_to(RoutingRegion const& region);
+
 	/**
 	 * @brief Run Dijkstra's algorithm.
+	 * As weights are integral, a monotone bucket queue (\c radix_heap) is used instead of
+	 * a binary heap.
+	 * If there is a single target and the search terminates once it has been reached, A*
+	 * is used instead: the search is guided towards the target HICANN by a lower bound on
+	 * the remaining distance, based on the HICANN grid distance and
+	 * L1EdgeWeights::min_weight().
 	 */
 	void run();
 
@@ -88,18 +122,26 @@ private:
 	graph_type const& m_graph;
 	vertex_descriptor m_source;
 	SwitchExclusiveness m_exclusiveness;
+	Termination m_termination;
 	std::unordered_map<target_type, target_vertices_type> m_targets;
-	std::vector<vertex_descriptor> m_predecessors;
+	/// Number of targets for which no vertex has been found yet.
+	size_t m_unreached_targets;
+	/// Region the search is restricted to, if any.
+	RoutingRegion const* m_region;
+	std::unique_ptr<RoutingWorkspace> m_own_workspace;
+	RoutingWorkspace& m_workspace;
+	/// Whether the search has been run, i.e. whether the workspace contains valid results.
+	bool m_searched;
 	/**
-	 * @brief Stores used crossbar switches to avoid multiple switches per line.
-	 * @note This only is in effect for paths to vertices belonging to a registered
-	 *       target.  Because of the traversal order in Dijkstra's algorithm, nearer
-	 *       targets are given preference.
-	 * This maps a vertex belonging to a vertical \c L1BusOnWafer, i.e. a \c VLineOnHICANN
-	 * with a \c HICANNOnWafer coordinate, to a vertex belonging to an horizontal \c
-	 * L1BusOnWafer.  This leads to a HICANN-local “1 switch per vertical line” rule.
+	 * @brief Switches added for the path to the current target, reused to avoid
+	 *        allocations.
+	 * Stored as pairs of horizontal and vertical bus.
+	 * Used crossbar switches themselves are tracked in the switch occupancy of the
+	 * workspace, to avoid multiple switches per line.  This only is in effect for paths
+	 * to vertices belonging to a registered target.  Because of the traversal order in
+	 * Dijkstra's algorithm, nearer targets are given preference.
 	 */
-	std::unordered_map<vertex_descriptor, vertex_descriptor> m_used_switches;
+	std::vector<vertex_descriptor> m_rollback;
 }; // L1DijkstraRouter
 
 } // namespace routing
@@ -1,47 +1,77 @@
 #include "marocco/routing/L1EdgeWeights.h"
 
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
 namespace marocco {
 namespace routing {
 
 L1EdgeWeights::L1EdgeWeights(graph_type const& graph)
-	: m_graph(graph)
+	: m_graph(graph),
+	  m_epoch(1),
+	  // Each undirected edge is stored as two directed arcs of the underlying graph.
+	  m_edge_weights(boost::num_edges(graph.m_g) / 2, Entry{0, 0}),
+	  m_vertex_weights(boost::num_vertices(graph), Entry{0, 0}),
+	  m_num_vertex_weights(0),
+	  m_min_edge_weight(max_weight()),
+	  m_min_vertex_weight(max_weight())
 {
 }
 
 void L1EdgeWeights::set_weight(edge_descriptor const& edge, weight_type weight)
 {
-	if (weight < 1) {
-		throw std::invalid_argument("weight has to be non-zero");
-	}
-	m_edge_weights[edge] = weight;
+	store(m_edge_weights, L1RoutingGraph::edge_index(m_graph, edge), weight);
+	m_min_edge_weight = std::min(m_min_edge_weight, weight);
 }
 
 void L1EdgeWeights::set_weight(vertex_descriptor const& vertex, weight_type weight)
 {
-	if (weight < 1) {
-		throw std::invalid_argument("weight has to be non-zero");
+	if (store(m_vertex_weights, vertex, weight)) {
+		++m_num_vertex_weights;
 	}
-	m_vertex_weights[vertex] = weight;
+	m_min_vertex_weight = std::min(m_min_vertex_weight, weight);
 }
 
-auto L1EdgeWeights::weight(edge_descriptor const& edge) const -> weight_type
+void L1EdgeWeights::set_weights(std::vector<edge_descriptor> const& edges, weight_type weight)
 {
-	weight_type weight = 1;
+	for (auto const& edge : edges) {
+		set_weight(edge, weight);
+	}
+}
 
-	auto it = m_edge_weights.find(edge);
-	if (it != m_edge_weights.end()) {
-		return it->second;
+void L1EdgeWeights::set_weights(
+    std::vector<vertex_descriptor> const& vertices, weight_type weight)
+{
+	for (auto const& vertex : vertices) {
+		set_weight(vertex, weight);
 	}
+}
 
-	// Note that edges in the routing graph are undirected.
-	for (auto const vertex : {boost::source(edge, m_graph), boost::target(edge, m_graph)}) {
-		auto it = m_vertex_weights.find(vertex);
-		if (it != m_vertex_weights.end()) {
-			weight = std::max(weight, it->second);
-		}
+void L1EdgeWeights::reset()
+{
+	m_num_vertex_weights = 0;
+	m_min_edge_weight = max_weight();
+	m_min_vertex_weight = max_weight();
+	++m_epoch;
+	if (m_epoch == 0) {
+		// Epoch counter wrapped around, entries of old epochs could become valid again.
+		std::fill(m_edge_weights.begin(), m_edge_weights.end(), Entry{0, 0});
+		std::fill(m_vertex_weights.begin(), m_vertex_weights.end(), Entry{0, 0});
+		m_epoch = 1;
 	}
+}
 
-	return weight;
+auto L1EdgeWeights::min_weight() const -> weight_type
+{
+	weight_type const vertex_weight =
+	    m_num_vertex_weights >= boost::num_vertices(m_graph) ? m_min_vertex_weight : 1;
+	return std::min(m_min_edge_weight, vertex_weight);
+}
+
+auto L1EdgeWeights::max_weight() -> weight_type
+{
+	return std::numeric_limits<std::uint32_t>::max();
 }
 
 auto L1EdgeWeights::graph() const -> graph_type const&
@@ -49,5 +79,22 @@ auto L1EdgeWeights::graph() const -> graph_type const&
 	return m_graph;
 }
 
+bool L1EdgeWeights::store(std::vector<Entry>& entries, size_t index, weight_type weight)
+{
+	if (weight < 1) {
+		throw std::invalid_argument("weight has to be non-zero");
+	}
+	if (weight > max_weight()) {
+		throw std::out_of_range("weight exceeds maximum weight");
+	}
+	// The routing graph may have been extended after construction of this object.
+	if (index >= entries.size()) {
+		entries.resize(index + 1, Entry{0, 0});
+	}
+	bool const is_new = entries[index].epoch != m_epoch;
+	entries[index] = Entry{m_epoch, static_cast<std::uint32_t>(weight)};
+	return is_new;
+}
+
 } // namespace routing
 } // namespace marocco
@@ -1,6 +1,8 @@
 #pragma once
 
-#include <unordered_map>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
 
 #include "marocco/routing/L1RoutingGraph.h"
 
@@ -14,6 +16,11 @@ namespace routing {
  * Weights are positive, non-zero numbers and can be set for both edges and vertices.
  * To calculate the effective weight of an edge, the maximum weight of its vertices is
  * used, but only if the weight of the edge has not been set explicitly.
+ *
+ * Weights are kept in dense arrays indexed by vertex and edge index, as they are looked
+ * up on every edge relaxation of Dijkstra's algorithm.  Each entry is stamped with the
+ * epoch it has been set in, so that all weights can be cleared in constant time via
+ * #reset().
  */
 class L1EdgeWeights
 {
@@ -21,36 +28,115 @@ public:
 	typedef L1RoutingGraph::graph_type graph_type;
 	typedef L1RoutingGraph::vertex_descriptor vertex_descriptor;
 	typedef L1RoutingGraph::edge_descriptor edge_descriptor;
+	typedef L1RoutingGraph::edge_index_type edge_index_type;
 	typedef size_t weight_type;
 
 	L1EdgeWeights(graph_type const& graph);
 
 	/**
 	 * @brief Sets weight for edge in routing graph.
+	 * As edges are undirected, this applies to both directions of the connection.
 	 * @param weight Non-zero weight to assign to this edge.
+	 * @throw std::invalid_argument If weight is zero.
+	 * @throw std::out_of_range If weight exceeds #max_weight().
 	 */
 	void set_weight(edge_descriptor const& edge, weight_type weight);
 
 	/**
 	 * @brief Sets weight for vertex in routing graph.
 	 * @param weight Non-zero weight to assign to this vertex.
+	 * @throw std::invalid_argument If weight is zero.
+	 * @throw std::out_of_range If weight exceeds #max_weight().
 	 */
 	void set_weight(vertex_descriptor const& vertex, weight_type weight);
 
+	/**
+	 * @brief Sets the same weight for all given edges.
+	 */
+	void set_weights(std::vector<edge_descriptor> const& edges, weight_type weight);
+
+	/**
+	 * @brief Sets the same weight for all given vertices.
+	 */
+	void set_weights(std::vector<vertex_descriptor> const& vertices, weight_type weight);
+
+	/**
+	 * @brief Removes all weights set via #set_weight() or #set_weights().
+	 * This does not touch the stored entries but starts a new epoch.
+	 */
+	void reset();
+
 	/**
 	 * @brief Calculates the effective weight for the specified edge.
 	 * If a weight has been set explicitly for this edge via #set_weight(), it is used.
 	 * Else, the maximum set weight for the vertices connected by this edge is used.
 	 * If neither is present, the minimum possible weight (`1`) is returned.
 	 */
-	weight_type weight(edge_descriptor const& edge) const;
+	weight_type weight(edge_descriptor const& edge) const
+	{
+		auto const edge_weight = lookup(m_edge_weights, L1RoutingGraph::edge_index(m_graph, edge));
+		if (edge_weight != 0) {
+			return edge_weight;
+		}
+
+		// Note that edges in the routing graph are undirected.
+		weight_type const weight = std::max(
+		    lookup(m_vertex_weights, boost::source(edge, m_graph)),
+		    lookup(m_vertex_weights, boost::target(edge, m_graph)));
+		return std::max(weight, weight_type(1));
+	}
+
+	/**
+	 * @brief Lower bound for the effective weight of all edges.
+	 * This is the minimum of all weights set in the current epoch, where vertex weights
+	 * are only taken into account if weights have been set for all vertices.  As
+	 * overwritten weights are not tracked, the bound is not necessarily tight.
+	 */
+	weight_type min_weight() const;
+
+	/**
+	 * @brief Largest weight that can be stored.
+	 */
+	static weight_type max_weight();
 
 	graph_type const& graph() const;
 
 private:
+	typedef std::uint32_t epoch_type;
+
+	/**
+	 * @brief Weight together with the epoch it has been set in.
+	 * Entries from previous epochs are treated as unset.
+	 */
+	struct Entry
+	{
+		epoch_type epoch;
+		std::uint32_t weight;
+	}; // Entry
+
+	weight_type lookup(std::vector<Entry> const& entries, size_t index) const
+	{
+		if (index >= entries.size()) {
+			return 0;
+		}
+		auto const& entry = entries[index];
+		return entry.epoch == m_epoch ? entry.weight : 0;
+	}
+
+	/**
+	 * @return Whether no weight had been set for this index in the current epoch.
+	 */
+	bool store(std::vector<Entry>& entries, size_t index, weight_type weight);
+
 	graph_type const& m_graph;
-	std::unordered_map<edge_descriptor, weight_type> m_edge_weights;
-	std::unordered_map<vertex_descriptor, weight_type> m_vertex_weights;
+	epoch_type m_epoch;
+	std::vector<Entry> m_edge_weights;
+	std::vector<Entry> m_vertex_weights;
+	/// Number of vertices with weights set in the current epoch.
+	size_t m_num_vertex_weights;
+	/// Minimum of all edge and vertex weights, respectively, set in the current epoch.
+	weight_type m_min_edge_weight;
+	weight_type m_min_vertex_weight;
 }; // L1EdgeWeights
 
 } // namespace routing
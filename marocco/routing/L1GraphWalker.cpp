@@ -20,6 +20,24 @@ L1GraphWalker::L1GraphWalker(
 void L1GraphWalker::avoid_using(vertex_descriptor const& vertex)
 {
 	m_avoid.insert(vertex);
+	m_walks.clear();
+	m_walks_by_vertex.clear();
+}
+
+void L1GraphWalker::invalidate(PathBundle const& bundle)
+{
+	for (auto const& path : bundle.paths()) {
+		for (vertex_descriptor const vertex : path) {
+			auto it = m_walks_by_vertex.find(vertex);
+			if (it == m_walks_by_vertex.end()) {
+				continue;
+			}
+			for (auto const& key : it->second) {
+				m_walks.erase(key);
+			}
+			m_walks_by_vertex.erase(it);
+		}
+	}
 }
 
 auto L1GraphWalker::change_orientation(vertex_descriptor const& vertex) const
@@ -116,30 +134,45 @@ auto L1GraphWalker::walk(
     vertex_descriptor const& vertex, Direction const& direction, size_t limit) const
 	-> std::pair<path_type, bool>
 {
-	if (direction == east) {
-		return walk_east(vertex, X(limit));
+	walk_key_type const key(vertex, direction.value(), limit);
+	auto it = m_walks.find(key);
+	if (it != m_walks.end()) {
+		return it->second;
 	}
-	if (direction == south) {
-		return walk_south(vertex, Y(limit));
+
+	std::pair<path_type, bool> result;
+	if (direction == east) {
+		result = walk_east(vertex, X(limit));
+	} else if (direction == south) {
+		result = walk_south(vertex, Y(limit));
+	} else if (direction == west) {
+		result = walk_west(vertex, X(limit));
+	} else {
+		result = walk_north(vertex, Y(limit));
 	}
-	if (direction == west) {
-		return walk_west(vertex, X(limit));
+
+	m_walks.emplace(key, result);
+	m_walks_by_vertex[vertex].push_back(key);
+	for (vertex_descriptor const other : result.first) {
+		m_walks_by_vertex[other].push_back(key);
 	}
-	return walk_north(vertex, Y(limit));
+	return result;
 }
 
 auto L1GraphWalker::detour_and_walk(
     vertex_descriptor const& vertex, Direction const& direction, size_t limit) const
     -> std::pair<path_type, bool>
 {
-	return detour_and_walk(vertex, direction, limit, path_type(boost::num_vertices(m_graph)));
+	RoutingWorkspace workspace;
+	workspace.reset(boost::num_vertices(m_graph));
+	return detour_and_walk(vertex, direction, limit, workspace);
 }
 
 auto L1GraphWalker::detour_and_walk(
     vertex_descriptor const& vertex,
     Direction const& direction,
     size_t limit,
-    path_type predecessors) const -> std::pair<path_type, bool>
+    RoutingWorkspace const& workspace) const -> std::pair<path_type, bool>
 {
 	if (m_graph[vertex].toOrientation() != direction.toOrientation()) {
 		throw std::invalid_argument(
@@ -161,7 +194,7 @@ auto L1GraphWalker::detour_and_walk(
 	path_type best_detour;
 
 	auto candidates = change_orientation(vertex);
-	candidates = L1_crossbar_restrictioning(vertex, candidates, predecessors, m_res_mgr, m_graph);
+	candidates = L1_crossbar_restrictioning(vertex, candidates, workspace, m_res_mgr, m_graph);
 
 	// sort candidates by longest possible extension.
 	// As branching is currently done after detouring the VLine should be able to reach far,
@@ -205,7 +238,7 @@ auto L1GraphWalker::detour_and_walk(
 				detour.push_back(other);
 				auto candidates_ = change_orientation(other);
 				candidates_ = L1_crossbar_restrictioning(
-				    other, candidates_, predecessors, m_res_mgr, m_graph);
+				    other, candidates_, workspace, m_res_mgr, m_graph);
 				for (auto const& candidate_ : candidates_) {
 					path_type extension;
 					bool reached_limit;
@@ -1,19 +1,30 @@
 #pragma once
 
 #include <set>
+#include <tuple>
+#include <unordered_map>
 #include <vector>
 #include <utility>
 
+#include <boost/functional/hash.hpp>
+
 #include "marocco/config.h"
 #include "marocco/resource/Manager.h"
 #include "marocco/routing/L1Routing.h"
 #include "marocco/routing/L1RoutingGraph.h"
+#include "marocco/routing/PathBundle.h"
+#include "marocco/routing/RoutingWorkspace.h"
 
 namespace marocco {
 namespace routing {
 
 /**
  * @brief Encapsulates traversal of the L1 routing graph across HICANN boundaries.
+ * Results of #walk() are memoized, as the backbone router repeatedly walks from the same
+ * vertices while scoring candidates.  A walk only depends on the vertices it visits, so
+ * cached results stay valid until one of these vertices is removed from the graph.
+ * @note Whenever vertices are removed from the underlying graph, #invalidate() has to be
+ *       called for them.
  */
 class L1GraphWalker {
 public:
@@ -38,6 +49,11 @@ public:
 	 */
 	void avoid_using(vertex_descriptor const& vertex);
 
+	/**
+	 * @brief Drops memoized walks that start at or pass any vertex of the given bundle.
+	 */
+	void invalidate(PathBundle const& bundle);
+
 	/**
 	 * @brief Finds the vertex that corresponds to stepping to an adjacent HICANN.
 	 * @param[in,out] vertex Vertex descriptor of the starting point.  If step succeeds
@@ -89,8 +105,8 @@ public:
 	 * @param [in] vertex : the vertex to start the detour from
 	 * @param [in] direction : in which direction shall it try to extend
 	 * @param [in] limit : the coordinate to stop
-	 * @param [in, optional] predecessors : a predecessor list, used to restrict switch usage to
-	 * allowed configurations
+	 * @param [in, optional] workspace : contains the predecessors of the current search, used to
+	 * restrict switch usage to allowed configurations
 	 *
 	 */
 	std::pair<path_type, bool> detour_and_walk(
@@ -102,7 +118,7 @@ public:
 	    vertex_descriptor const& vertex,
 	    halco::common::Direction const& direction,
 	    size_t limit,
-	    path_type predecessors) const;
+	    RoutingWorkspace const& workspace) const;
 
 	graph_type const& graph() const;
 
@@ -122,9 +138,17 @@ private:
 	std::pair<path_type, bool> walk_west(
 		vertex_descriptor const& vertex, x_type const& limit) const;
 
+	/// Start vertex, direction and limit of a walk.
+	typedef std::tuple<vertex_descriptor, size_t, size_t> walk_key_type;
+
 	graph_type const& m_graph;
 	std::set<vertex_descriptor> m_avoid;
 
+	mutable std::unordered_map<walk_key_type, std::pair<path_type, bool>, boost::hash<walk_key_type> >
+	    m_walks;
+	/// Memoized walks that start at or pass each vertex.  May contain stale keys.
+	mutable std::unordered_map<vertex_descriptor, std::vector<walk_key_type> > m_walks_by_vertex;
+
 	boost::optional<resource::HICANNManager&> m_res_mgr;
 }; // L1GraphWalker
 
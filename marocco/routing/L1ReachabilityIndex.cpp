@@ -0,0 +1,201 @@
+#include "marocco/routing/L1ReachabilityIndex.h"
+
+#include <algorithm>
+
+#include "halco/common/iter_all.h"
+#include "marocco/util/iterable.h"
+
+using namespace halco::hicann::v2;
+using namespace halco::common;
+
+namespace marocco {
+namespace routing {
+
+L1ReachabilityIndex::L1ReachabilityIndex(L1RoutingGraph const& graph) :
+    m_graph(graph),
+    m_components(boost::num_vertices(graph.graph()), removed()),
+    m_num_components(0),
+    m_stack(),
+    m_visited(m_components.size(), 0),
+    m_owner(m_components.size(), 0),
+    m_update(0)
+{
+	for (vertex_descriptor vertex = 0; vertex < m_components.size(); ++vertex) {
+		if (m_graph.is_removed(vertex) || m_components[vertex] != removed()) {
+			continue;
+		}
+		label(vertex, m_num_components++);
+	}
+}
+
+void L1ReachabilityIndex::update(PathBundle const& bundle)
+{
+	std::vector<vertex_descriptor> vertices;
+	for (auto const& path : bundle.paths()) {
+		for (vertex_descriptor const vertex : path) {
+			if (m_components[vertex] != removed()) {
+				m_components[vertex] = removed();
+				vertices.push_back(vertex);
+			}
+		}
+	}
+
+	// Remaining neighbors of removed buses, grouped by their component.  Removed vertices
+	// are hidden by the filtered graph, so their neighbors are looked up in the storage.
+	auto const& storage = m_graph.storage();
+	std::vector<std::pair<component_type, vertex_descriptor> > seeds;
+	for (vertex_descriptor const vertex : vertices) {
+		for (auto const other : make_iterable(boost::adjacent_vertices(vertex, storage))) {
+			if (m_components[other] != removed()) {
+				seeds.emplace_back(m_components[other], other);
+			}
+		}
+	}
+	std::sort(seeds.begin(), seeds.end());
+	seeds.erase(std::unique(seeds.begin(), seeds.end()), seeds.end());
+
+	std::vector<vertex_descriptor> component_seeds;
+	for (auto it = seeds.begin(); it != seeds.end();) {
+		component_seeds.clear();
+		component_type const component = it->first;
+		for (; it != seeds.end() && it->first == component; ++it) {
+			component_seeds.push_back(it->second);
+		}
+		split(component_seeds);
+	}
+}
+
+void L1ReachabilityIndex::split(std::vector<vertex_descriptor> const& seeds)
+{
+	// Each part of the split component contains at least one seed.
+	if (seeds.size() < 2) {
+		return;
+	}
+
+	struct Search
+	{
+		std::vector<vertex_descriptor> stack;
+		std::vector<vertex_descriptor> visited;
+		/// Searches that met each other explore the same part, see #find().
+		size_t parent;
+		/// Number of unfinished searches in this part, only valid for root.
+		size_t open;
+	};
+
+	++m_update;
+	std::vector<Search> searches(seeds.size());
+	for (size_t ii = 0; ii < seeds.size(); ++ii) {
+		searches[ii].stack.push_back(seeds[ii]);
+		searches[ii].visited.push_back(seeds[ii]);
+		searches[ii].parent = ii;
+		searches[ii].open = 1;
+		m_visited[seeds[ii]] = m_update;
+		m_owner[seeds[ii]] = ii;
+	}
+
+	auto find = [&searches](size_t search) {
+		while (searches[search].parent != search) {
+			search = searches[search].parent = searches[searches[search].parent].parent;
+		}
+		return search;
+	};
+
+	auto const& graph = m_graph.graph();
+	size_t open_parts = seeds.size();
+	while (open_parts > 1) {
+		for (size_t ii = 0; ii < searches.size() && open_parts > 1; ++ii) {
+			Search& search = searches[ii];
+			if (search.stack.empty()) {
+				continue;
+			}
+
+			vertex_descriptor const vertex = search.stack.back();
+			search.stack.pop_back();
+			for (auto const other : make_iterable(boost::adjacent_vertices(vertex, graph))) {
+				if (m_visited[other] != m_update) {
+					m_visited[other] = m_update;
+					m_owner[other] = ii;
+					search.stack.push_back(other);
+					search.visited.push_back(other);
+					continue;
+				}
+				size_t const lhs = find(ii);
+				size_t const rhs = find(m_owner[other]);
+				if (lhs != rhs) {
+					// Both searches are part of the same piece.
+					searches[rhs].parent = lhs;
+					searches[lhs].open += searches[rhs].open;
+					--open_parts;
+				}
+			}
+
+			if (!search.stack.empty()) {
+				continue;
+			}
+
+			size_t const root = find(ii);
+			if (--searches[root].open > 0) {
+				continue;
+			}
+
+			// Piece has been traversed completely and is split off.
+			--open_parts;
+			component_type const component = m_num_components++;
+			for (size_t jj = 0; jj < searches.size(); ++jj) {
+				if (find(jj) != root) {
+					continue;
+				}
+				for (vertex_descriptor const member : searches[jj].visited) {
+					m_components[member] = component;
+				}
+			}
+		}
+	}
+	// The remaining piece keeps the label of the original component.
+}
+
+bool L1ReachabilityIndex::reachable(vertex_descriptor source, Target const& target) const
+{
+	component_type const component = m_components[source];
+	if (component == removed()) {
+		return false;
+	}
+
+	auto const& hicann = m_graph[target.toHICANNOnWafer()];
+	if (target.toOrientation() == vertical) {
+		for (auto const vline : iter_all<VLineOnHICANN>()) {
+			if (m_components[hicann[vline]] == component) {
+				return true;
+			}
+		}
+	} else {
+		for (auto const hline : iter_all<HLineOnHICANN>()) {
+			if (m_components[hicann[hline]] == component) {
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+void L1ReachabilityIndex::label(vertex_descriptor start, component_type component)
+{
+	auto const& graph = m_graph.graph();
+	m_stack.clear();
+	m_stack.push_back(start);
+	m_components[start] = component;
+	while (!m_stack.empty()) {
+		vertex_descriptor const vertex = m_stack.back();
+		m_stack.pop_back();
+		// Edges incident to removed vertices are hidden by the filtered graph.
+		for (auto const other : make_iterable(boost::adjacent_vertices(vertex, graph))) {
+			if (m_components[other] == removed()) {
+				m_components[other] = component;
+				m_stack.push_back(other);
+			}
+		}
+	}
+}
+
+} // namespace routing
+} // namespace marocco
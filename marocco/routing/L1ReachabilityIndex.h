@@ -0,0 +1,87 @@
+#pragma once
+
+#include <limits>
+#include <vector>
+
+#include "marocco/routing/L1RoutingGraph.h"
+#include "marocco/routing/PathBundle.h"
+#include "marocco/routing/Target.h"
+
+namespace marocco {
+namespace routing {
+
+/**
+ * @brief Connected components of the L1 routing graph, used to detect unreachable
+ *        targets without searching.
+ * Removing buses can only split components.  Every part split off a component has to
+ * be adjacent to one of the removed buses.  Thus, when paths are removed from the graph,
+ * the neighbors of the removed buses are searched simultaneously and the searches stop
+ * as soon as a single unfinished part remains.  This part keeps the label of the original
+ * component, while only the parts that were completely traversed are labeled anew.  The
+ * cost of an update is thus bounded by the size of the smaller parts, not by the size of
+ * the (typically wafer-spanning) component.
+ * Being in the same component is necessary but not sufficient for a route to exist, as
+ * routers impose further restrictions, e.g. on the use of crossbar switches.
+ * @note #update() has to be called for each removal after construction of the index.
+ */
+class L1ReachabilityIndex
+{
+public:
+	typedef L1RoutingGraph::vertex_descriptor vertex_descriptor;
+	typedef size_t component_type;
+
+	L1ReachabilityIndex(L1RoutingGraph const& graph);
+
+	/**
+	 * @brief Updates the components after the given paths have been removed from the graph.
+	 */
+	void update(PathBundle const& bundle);
+
+	/**
+	 * @brief Checks whether any bus of the given orientation on the target HICANN may be
+	 *        reached from the given source.
+	 */
+	bool reachable(vertex_descriptor source, Target const& target) const;
+
+	/**
+	 * @brief Returns the component of the given vertex or #removed() for removed vertices.
+	 */
+	component_type component(vertex_descriptor vertex) const
+	{
+		return m_components[vertex];
+	}
+
+	static constexpr component_type removed()
+	{
+		return std::numeric_limits<component_type>::max();
+	}
+
+private:
+	/**
+	 * @brief Labels all vertices reachable from the given vertex.
+	 */
+	void label(vertex_descriptor start, component_type component);
+
+	/**
+	 * @brief Relabels the parts of a component that have been split off by the removal
+	 *        of buses.
+	 * @param seeds Remaining vertices of the component adjacent to removed buses.
+	 */
+	void split(std::vector<vertex_descriptor> const& seeds);
+
+	L1RoutingGraph const& m_graph;
+	/// Component of each vertex.
+	std::vector<component_type> m_components;
+	/// Number of labels handed out so far.
+	component_type m_num_components;
+	/// Scratch space for traversals.
+	std::vector<vertex_descriptor> m_stack;
+	/// Last update in which each vertex has been visited, see #split().
+	std::vector<size_t> m_visited;
+	/// Search that visited each vertex first, valid if visited in current update.
+	std::vector<size_t> m_owner;
+	size_t m_update;
+}; // L1ReachabilityIndex
+
+} // namespace routing
+} // namespace marocco
@@ -0,0 +1,283 @@
+#include "marocco/routing/L1RouteCache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+#include <unistd.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/functional/hash.hpp>
+
+#include "marocco/Logger.h"
+
+using namespace halco::hicann::v2;
+using namespace halco::common;
+
+namespace marocco {
+namespace routing {
+
+namespace {
+
+typedef std::uint64_t word_type;
+
+/// Has to be incremented whenever the layout of the file changes.
+word_type const format_version = 1;
+char const magic[8] = {'M', 'A', 'R', 'O', 'C', 'C', 'O', 'R'};
+
+struct Header
+{
+	char magic[8];
+	word_type version;
+	word_type graph_key;
+	word_type parameters_key;
+	word_type num_entries;
+}; // Header
+
+class WordWriter
+{
+public:
+	WordWriter(std::ostream& os) : m_os(os) {}
+
+	void put(word_type word)
+	{
+		m_os.write(reinterpret_cast<char const*>(&word), sizeof(word_type));
+	}
+
+private:
+	std::ostream& m_os;
+}; // WordWriter
+
+class WordReader
+{
+public:
+	WordReader(std::istream& is) : m_is(is) {}
+
+	word_type get()
+	{
+		word_type word;
+		if (!m_is.read(reinterpret_cast<char*>(&word), sizeof(word_type))) {
+			throw std::runtime_error("truncated L1 route cache file");
+		}
+		return word;
+	}
+
+	/**
+	 * @brief Reads a count and makes sure it does not exceed the given bound.
+	 */
+	size_t get_count(size_t bound)
+	{
+		word_type const count = get();
+		if (count > bound) {
+			throw std::runtime_error("implausible count");
+		}
+		return count;
+	}
+
+private:
+	std::istream& m_is;
+}; // WordReader
+
+} // namespace
+
+L1RouteCache::L1RouteCache(
+    std::string const& directory,
+    L1RoutingGraphCache::key_type graph_key,
+    parameters::L1Routing const& parameters) :
+    m_directory(directory), m_graph_key(graph_key), m_parameters_key(0), m_entries()
+{
+	size_t hash = 0;
+	boost::hash_combine(hash, format_version);
+	boost::hash_combine(hash, static_cast<size_t>(parameters.algorithm()));
+	boost::hash_combine(hash, static_cast<size_t>(parameters.switch_ordering()));
+	boost::hash_combine(hash, parameters.shuffle_switches_seed());
+	boost::hash_combine(hash, parameters.speculative_batch_size());
+	boost::hash_combine(hash, parameters.negotiated_congestion_iterations());
+	boost::hash_combine(hash, parameters.corridor_margin());
+	m_parameters_key = hash;
+}
+
+bool L1RouteCache::enabled() const
+{
+	return !m_directory.empty();
+}
+
+std::string L1RouteCache::path() const
+{
+	std::ostringstream filename;
+	filename << "l1_routes-" << std::hex << std::setfill('0') << std::setw(16) << m_graph_key
+	         << "-" << std::setw(16) << m_parameters_key << ".bin";
+	return (boost::filesystem::path(m_directory) / filename.str()).string();
+}
+
+auto L1RouteCache::key(DNCMergerOnWafer const& source, targets_type const& targets) const
+    -> key_type
+{
+	size_t hash = m_parameters_key;
+	boost::hash_combine(hash, source.toHICANNOnWafer().toEnum().value());
+	boost::hash_combine(hash, source.toDNCMergerOnHICANN().value());
+	for (auto const& target : targets) {
+		boost::hash_combine(hash, target.toEnum().value());
+	}
+	return hash;
+}
+
+auto L1RouteCache::find(DNCMergerOnWafer const& source, targets_type const& targets) const
+    -> paths_type const*
+{
+	auto it = m_entries.find(key(source, targets));
+	if (it == m_entries.end()) {
+		return nullptr;
+	}
+	// Guard against hash collisions.
+	auto const& entry = it->second;
+	if (entry.source != source || entry.targets != targets) {
+		return nullptr;
+	}
+	return &entry.paths;
+}
+
+void L1RouteCache::insert(
+    DNCMergerOnWafer const& source, targets_type const& targets, paths_type const& paths)
+{
+	if (paths.size() != targets.size()) {
+		throw std::invalid_argument("number of paths does not match number of targets");
+	}
+	m_entries[key(source, targets)] = Entry{source, targets, paths};
+}
+
+size_t L1RouteCache::size() const
+{
+	return m_entries.size();
+}
+
+bool L1RouteCache::load(size_t num_vertices)
+{
+	if (!enabled()) {
+		return false;
+	}
+
+	std::string const filename = path();
+	if (!boost::filesystem::exists(filename)) {
+		MAROCCO_DEBUG("no cached L1 routes at " << filename);
+		return false;
+	}
+
+	std::unordered_map<key_type, Entry> entries;
+	try {
+		std::ifstream is(filename, std::ios::binary);
+		Header header;
+		if (!is.read(reinterpret_cast<char*>(&header), sizeof(Header))) {
+			throw std::runtime_error("truncated header");
+		}
+		if (std::memcmp(header.magic, magic, sizeof(magic)) != 0 ||
+		    header.version != format_version || header.graph_key != m_graph_key ||
+		    header.parameters_key != m_parameters_key) {
+			throw std::runtime_error("incompatible header");
+		}
+
+		WordReader reader(is);
+		size_t const max_targets = HICANNOnWafer::enum_type::size;
+		for (size_t ii = 0; ii < header.num_entries; ++ii) {
+			Entry entry;
+			auto const hicann = reader.get_count(HICANNOnWafer::enum_type::max);
+			auto const merger = reader.get_count(DNCMergerOnHICANN::max);
+			entry.source = DNCMergerOnWafer(DNCMergerOnHICANN(merger), HICANNOnWafer(Enum(hicann)));
+
+			size_t const num_targets = reader.get_count(max_targets);
+			entry.targets.reserve(num_targets);
+			for (size_t jj = 0; jj < num_targets; ++jj) {
+				entry.targets.push_back(
+				    HICANNOnWafer(Enum(reader.get_count(HICANNOnWafer::enum_type::max))));
+			}
+			if (!std::is_sorted(entry.targets.begin(), entry.targets.end())) {
+				throw std::runtime_error("unsorted targets");
+			}
+
+			entry.paths.resize(num_targets);
+			for (auto& path : entry.paths) {
+				size_t const length = reader.get_count(num_vertices);
+				path.reserve(length);
+				for (size_t kk = 0; kk < length; ++kk) {
+					path.push_back(reader.get_count(num_vertices - 1));
+				}
+			}
+
+			auto const entry_key = key(entry.source, entry.targets);
+			entries[entry_key] = std::move(entry);
+		}
+		if (is.peek() != std::ifstream::traits_type::eof()) {
+			throw std::runtime_error("trailing data");
+		}
+	} catch (std::exception const& err) {
+		MAROCCO_WARN("ignoring invalid L1 route cache file " << filename << ": " << err.what());
+		return false;
+	}
+
+	// Keep entries of the current run.
+	for (auto& item : entries) {
+		m_entries.insert(std::move(item));
+	}
+
+	MAROCCO_INFO("Restored " << entries.size() << " cached L1 routes from " << filename);
+	return true;
+}
+
+void L1RouteCache::store() const
+{
+	if (!enabled()) {
+		return;
+	}
+
+	Header header;
+	std::memcpy(header.magic, magic, sizeof(magic));
+	header.version = format_version;
+	header.graph_key = m_graph_key;
+	header.parameters_key = m_parameters_key;
+	header.num_entries = m_entries.size();
+
+	boost::filesystem::path const filename(path());
+	boost::filesystem::path temporary(filename);
+	temporary += ".tmp" + std::to_string(::getpid());
+
+	try {
+		boost::filesystem::create_directories(filename.parent_path());
+		{
+			std::ofstream os(temporary.string(), std::ios::binary | std::ios::trunc);
+			os.write(reinterpret_cast<char const*>(&header), sizeof(Header));
+			WordWriter writer(os);
+			for (auto const& item : m_entries) {
+				auto const& entry = item.second;
+				writer.put(entry.source.toHICANNOnWafer().toEnum().value());
+				writer.put(entry.source.toDNCMergerOnHICANN().value());
+				writer.put(entry.targets.size());
+				for (auto const& target : entry.targets) {
+					writer.put(target.toEnum().value());
+				}
+				for (auto const& path : entry.paths) {
+					writer.put(path.size());
+					for (auto const vertex : path) {
+						writer.put(vertex);
+					}
+				}
+			}
+			if (!os) {
+				throw std::runtime_error("could not write file");
+			}
+		}
+		boost::filesystem::rename(temporary, filename);
+	} catch (std::exception const& err) {
+		MAROCCO_WARN("could not store L1 routes in " << filename << ": " << err.what());
+		boost::system::error_code ignored;
+		boost::filesystem::remove(temporary, ignored);
+		return;
+	}
+
+	MAROCCO_INFO("Stored " << m_entries.size() << " L1 routes in " << filename);
+}
+
+} // namespace routing
+} // namespace marocco
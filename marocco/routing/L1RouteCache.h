@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "halco/hicann/v2/l1.h"
+#include "marocco/routing/L1RoutingGraphCache.h"
+#include "marocco/routing/PathBundle.h"
+#include "marocco/routing/parameters/L1Routing.h"
+
+namespace marocco {
+namespace routing {
+
+/**
+ * @brief Persistent on-disk cache of L1 routes, shared across mapping runs.
+ * Each entry holds the paths from a single DNC merger to a set of target HICANNs.
+ * Entries are keyed by the source, the sorted set of targets and the parameters of the
+ * routing algorithm.  All entries of one file belong to the same routing graph, as
+ * identified by L1RoutingGraphCache::fingerprint(), so stored vertex descriptors stay
+ * valid.  Cached routes are only a proposal: the caller has to check that all buses
+ * used are still available before committing them.
+ */
+class L1RouteCache
+{
+public:
+	typedef std::uint64_t key_type;
+	/// Paths to the targets, in the order of the sorted targets passed alongside.
+	typedef std::vector<PathBundle::path_type> paths_type;
+	typedef std::vector<halco::hicann::v2::HICANNOnWafer> targets_type;
+
+	/**
+	 * @param directory Directory used to store cached routes.  If empty, the cache is
+	 *                  disabled.
+	 * @param graph_key Fingerprint of the routing graph the routes refer to.
+	 * @param parameters Parameters of the L1 routing algorithm.
+	 */
+	L1RouteCache(
+	    std::string const& directory,
+	    L1RoutingGraphCache::key_type graph_key,
+	    parameters::L1Routing const& parameters);
+
+	bool enabled() const;
+
+	/**
+	 * @brief Returns the path of the file used to store the routes.
+	 */
+	std::string path() const;
+
+	/**
+	 * @brief Looks up the routes from the given source to the given targets.
+	 * @param targets Target HICANNs, sorted in ascending order.
+	 * @return Pointer to the cached paths or \c nullptr if there is no entry.
+	 */
+	paths_type const* find(
+	    halco::hicann::v2::DNCMergerOnWafer const& source, targets_type const& targets) const;
+
+	/**
+	 * @brief Adds or replaces the routes from the given source to the given targets.
+	 * @param targets Target HICANNs, sorted in ascending order.
+	 * @param paths Paths in the order of \c targets.  Empty paths mark failed routes.
+	 * @throw std::invalid_argument If the number of paths does not match the targets.
+	 */
+	void insert(
+	    halco::hicann::v2::DNCMergerOnWafer const& source,
+	    targets_type const& targets,
+	    paths_type const& paths);
+
+	size_t size() const;
+
+	/**
+	 * @brief Reads entries from disk.
+	 * Entries already present in memory take precedence over those on disk.
+	 * @param num_vertices Number of vertices of the routing graph, used for validation.
+	 * @return Whether a valid file was found.
+	 */
+	bool load(size_t num_vertices);
+
+	/**
+	 * @brief Writes all entries to disk.
+	 * The file is written to a temporary location first and then renamed, so concurrent
+	 * mapping runs never observe partially written files.
+	 */
+	void store() const;
+
+private:
+	struct Entry
+	{
+		halco::hicann::v2::DNCMergerOnWafer source;
+		targets_type targets;
+		paths_type paths;
+	}; // Entry
+
+	key_type key(
+	    halco::hicann::v2::DNCMergerOnWafer const& source, targets_type const& targets) const;
+
+	std::string m_directory;
+	L1RoutingGraphCache::key_type m_graph_key;
+	/// Hash of the parameters that influence the resulting routes.
+	key_type m_parameters_key;
+	std::unordered_map<key_type, Entry> m_entries;
+}; // L1RouteCache
+
+} // namespace routing
+} // namespace marocco
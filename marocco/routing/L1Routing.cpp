@@ -1,11 +1,20 @@
 #include "marocco/routing/L1Routing.h"
 
 #include <algorithm>
+#include <cmath>
+#include <map>
+
+#include <boost/dynamic_bitset.hpp>
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
 
 #include "marocco/Logger.h"
+#include "marocco/placement/internal/FiringRateVisitor.h"
 #include "marocco/routing/L1BackboneRouter.h"
+#include "marocco/routing/L1CorridorPlanner.h"
 #include "marocco/routing/L1DijkstraRouter.h"
-#include "marocco/routing/SynapseDriverRequirementPerSource.h"
+#include "marocco/routing/L1SteinerRouter.h"
 #include "marocco/routing/SynapseDriverRequirements.h"
 #include "marocco/routing/VLineUsage.h"
 #include "marocco/routing/internal/SynapseTargetMapping.h"
@@ -20,6 +29,13 @@ namespace routing {
 
 namespace {
 
+/**
+ * @brief Weight of horizontal buses driven by sending repeaters of other sources.
+ * Routes should only use these buses if there is no alternative, as the corresponding
+ * sources could not be routed otherwise.
+ */
+L1EdgeWeights::weight_type const sending_repeater_penalty = 10000;
+
 L1Route::segment_type to_segment(L1BusOnWafer const& bus)
 {
 	if (bus.is_horizontal()) {
@@ -36,13 +52,24 @@ L1Routing::L1Routing(
     parameters::L1Routing const& parameters,
     placement::results::Placement const& neuron_placement,
     results::L1Routing& result,
-    resource::HICANNManager& resource_manager) :
+    resource::HICANNManager& resource_manager,
+    double speedup,
+    boost::optional<L1RouteCache&> route_cache) :
     m_l1_graph(l1_graph),
     m_bio_graph(bio_graph),
     m_parameters(parameters),
     m_neuron_placement(neuron_placement),
     m_result(result),
-    m_resource_manager(resource_manager)
+    m_resource_manager(resource_manager),
+    m_speedup(speedup),
+    m_route_cache(route_cache),
+    m_previous(),
+    m_reroute(),
+    m_driver_requirements(bio_graph, neuron_placement),
+    m_workspace(),
+    m_reachability(l1_graph),
+    m_source_rates(),
+    m_bus_rates()
 {
 }
 
@@ -97,28 +124,144 @@ std::vector<DNCMergerOnWafer> L1Routing::sources_sorted_by_priority() const
 	return result;
 }
 
+void L1Routing::keep_routes(
+    results::L1Routing const& previous, std::set<DNCMergerOnWafer> const& reroute)
+{
+	m_previous = previous;
+	m_reroute = reroute;
+}
+
 void L1Routing::run()
 {
+	auto sources = sources_sorted_by_priority();
+	MAROCCO_DEBUG("found " << sources.size() << " sources");
+
+	m_source_rates = estimate_source_rates();
+	sources = apply_bus_rate_budget(sources);
+
+	if (m_previous) {
+		sources = replay_previous_routes(sources);
+	}
+
+	if (m_route_cache) {
+		sources = replay_cached_routes(sources);
+	}
+
 	switch (m_parameters.algorithm()) {
 		case parameters::L1Routing::Algorithm::backbone:
-			run_backbone_router();
+			run_backbone_router(sources);
 			break;
 		case parameters::L1Routing::Algorithm::dijkstra:
-			run_dijkstra_router();
+			run_dijkstra_router(sources);
+			break;
+		case parameters::L1Routing::Algorithm::negotiated_congestion:
+			run_negotiated_congestion_router(sources);
+			break;
+		case parameters::L1Routing::Algorithm::steiner:
+			run_steiner_router(sources);
+			break;
+		case parameters::L1Routing::Algorithm::hierarchical:
+			run_hierarchical_router(sources);
 			break;
 		default:
 			throw std::runtime_error("unknown routing algorithm");
 	}
+
+	report_bus_rates();
+}
+
+std::unordered_map<DNCMergerOnWafer, double> L1Routing::estimate_source_rates() const
+{
+	auto const& graph = m_bio_graph.graph();
+	placement::internal::FiringRateVisitor visitor(m_speedup);
+
+	std::unordered_map<DNCMergerOnWafer, double> rates;
+	for (auto const& item : m_neuron_placement) {
+		auto const merger = item.dnc_merger();
+		if (merger == boost::none || !is_source(item.population(), graph)) {
+			continue;
+		}
+		auto const& population = *graph[item.population()];
+		rates[*merger] +=
+		    visitCellParameterVector(population.parameters(), visitor, item.neuron_index());
+	}
+	return rates;
 }
 
-void L1Routing::run_backbone_router()
+std::vector<DNCMergerOnWafer> L1Routing::apply_bus_rate_budget(
+    std::vector<DNCMergerOnWafer> const& sources)
+{
+	double const budget = m_parameters.bus_rate_budget();
+	if (budget == 0.) {
+		return sources;
+	}
+
+	bool const enforce = m_parameters.enforce_bus_rate_budget();
+	auto const& drv_per_src = m_driver_requirements;
+
+	std::vector<DNCMergerOnWafer> remaining;
+	remaining.reserve(sources.size());
+	for (auto const& merger : sources) {
+		auto const it = m_source_rates.find(merger);
+		double const rate = it == m_source_rates.end() ? 0. : it->second;
+		if (rate <= budget) {
+			remaining.push_back(merger);
+			continue;
+		}
+
+		if (!enforce) {
+			MAROCCO_WARN(
+			    "predicted event rate of " << rate << " Hz for " << merger
+			                               << " exceeds L1 bus rate budget of " << budget
+			                               << " Hz, events may be lost");
+			remaining.push_back(merger);
+			continue;
+		}
+
+		MAROCCO_WARN(
+		    "not routing " << merger << " as its predicted event rate of " << rate
+		                   << " Hz exceeds L1 bus rate budget of " << budget << " Hz");
+		for (auto const& target : drv_per_src.targets_for_source(merger)) {
+			m_rejected.push_back(request_type{merger, target.first, target.second});
+		}
+	}
+	return remaining;
+}
+
+void L1Routing::report_bus_rates() const
+{
+	if (m_bus_rates.empty()) {
+		return;
+	}
+
+	auto const busiest = std::max_element(
+	    m_bus_rates.begin(), m_bus_rates.end(),
+	    [](bus_rates_type::value_type const& lhs, bus_rates_type::value_type const& rhs) {
+		    return lhs.second < rhs.second;
+	    });
+	MAROCCO_INFO(
+	    "Highest predicted L1 bus rate is " << busiest->second << " Hz on " << busiest->first);
+
+	double const budget = m_parameters.bus_rate_budget();
+	if (budget == 0.) {
+		return;
+	}
+
+	size_t const n_exceeding = std::count_if(
+	    m_bus_rates.begin(), m_bus_rates.end(),
+	    [budget](bus_rates_type::value_type const& item) { return item.second > budget; });
+	if (n_exceeding != 0) {
+		MAROCCO_WARN(
+		    n_exceeding << " of " << m_bus_rates.size()
+		                << " used L1 buses exceed the bus rate budget of " << budget << " Hz");
+	}
+}
+
+void L1Routing::run_backbone_router(std::vector<DNCMergerOnWafer> const& sources)
 {
 	MAROCCO_INFO("Beginning L1 routing using backbone router");
 	auto const& graph = m_l1_graph.graph();
 
-	auto const sources = sources_sorted_by_priority();
-	MAROCCO_DEBUG("found " << sources.size() << " sources");
-
 	L1GraphWalker walker(graph, m_resource_manager);
 
 	// Avoid horizontal buses belonging to used sending repeaters.
@@ -150,8 +293,7 @@ void L1Routing::run_backbone_router()
 			return vline_usage.get(bus.toHICANNOnWafer(), bus.toVLineOnHICANN()) < 12 ? 3 : 2;
 		});
 
-	auto const drv_per_src =
-	    SynapseDriverRequirementPerSource(m_bio_graph.graph(), m_neuron_placement);
+	auto const& drv_per_src = m_driver_requirements;
 	boost::optional<resource::HICANNManager&> res_mgr_o(m_resource_manager);
 	for (auto const& merger : sources) {
 		auto const source = m_l1_graph[merger.toHICANNOnWafer()]
@@ -160,15 +302,26 @@ void L1Routing::run_backbone_router()
 
 		MAROCCO_TRACE("routing from " << merger << " to " << targets.size() << " targets");
 
-		L1BackboneRouter backbone(walker, source, scoring_function, res_mgr_o);
+		L1BackboneRouter backbone(walker, source, scoring_function, res_mgr_o, m_workspace);
 
+		// Unreachable targets are not searched for.
+		bool any_reachable = false;
 		for (auto const& target : targets) {
-			backbone.add_target(target.first);
+			if (m_reachability.reachable(source, Target(target.first, vertical))) {
+				backbone.add_target(target.first);
+				any_reachable = true;
+			} else {
+				MAROCCO_TRACE("skipping unreachable target " << target.first);
+			}
 		}
 
-		backbone.run();
+		if (any_reachable) {
+			backbone.run();
+		}
 
 		PathBundle bundle;
+		paths_type paths;
+		paths.reserve(targets.size());
 		for (auto const& target : targets) {
 			auto const path = backbone.path_to(target.first);
 
@@ -176,60 +329,571 @@ void L1Routing::run_backbone_router()
 				vline_usage.increment(m_l1_graph[path.back()].toHICANNOnWafer(), m_l1_graph[path.back()].toVLineOnHICANN());
 				bundle.add(path);
 			}
+			paths.push_back(path);
 		}
 		m_l1_graph.remove(bundle);
+		m_reachability.update(bundle);
+		walker.invalidate(bundle);
+		remember(merger, targets, paths);
 	}
 }
 
-void L1Routing::run_dijkstra_router()
+std::vector<L1RoutingGraph::vertex_descriptor> L1Routing::sending_repeater_buses(
+    std::vector<DNCMergerOnWafer> const& sources) const
 {
-	MAROCCO_INFO("Beginning L1 routing using dijkstra router");
-	auto const sources = sources_sorted_by_priority();
-	MAROCCO_DEBUG("found " << sources.size() << " sources");
+	std::vector<L1RoutingGraph::vertex_descriptor> buses;
+	buses.reserve(sources.size());
+	for (auto const& merger : sources) {
+		buses.push_back(
+			m_l1_graph[merger.toHICANNOnWafer()]
+			          [merger.toSendingRepeaterOnHICANN().toHLineOnHICANN()]);
+	}
+	return buses;
+}
 
-	L1EdgeWeights weights(m_l1_graph.graph());
+auto L1Routing::route_with_dijkstra(
+    L1EdgeWeights const& weights,
+    DNCMergerOnWafer const& merger,
+    targets_type const& targets,
+    RoutingWorkspace& workspace,
+    boost::optional<RoutingRegion const&> region) const -> paths_type
+{
+	auto const source = m_l1_graph[merger.toHICANNOnWafer()]
+	                              [merger.toSendingRepeaterOnHICANN().toHLineOnHICANN()];
 
-	// Avoid horizontal buses belonging to used sending repeaters.
+	MAROCCO_TRACE("routing from " << merger << " to " << targets.size() << " targets");
+
+	L1DijkstraRouter dijkstra(
+	    weights, source, L1DijkstraRouter::SwitchExclusiveness::global,
+	    L1DijkstraRouter::Termination::all_targets_reached, workspace);
+	if (region) {
+		dijkstra.restrict_to(*region);
+	}
+
+	// Unreachable targets are not searched for.
+	std::vector<bool> reachable;
+	reachable.reserve(targets.size());
+	for (auto const& target : targets) {
+		Target const target_(target.first, vertical);
+		reachable.push_back(m_reachability.reachable(source, target_));
+		if (reachable.back()) {
+			dijkstra.add_target(target_);
+		} else {
+			MAROCCO_TRACE("skipping unreachable target " << target.first);
+		}
+	}
+
+	if (std::find(reachable.begin(), reachable.end(), true) != reachable.end()) {
+		dijkstra.run();
+	}
+
+	paths_type paths;
+	paths.reserve(targets.size());
+	auto is_reachable = reachable.begin();
+	for (auto const& target : targets) {
+		PathBundle::path_type path;
+		if (!*(is_reachable++)) {
+			paths.push_back(path);
+			continue;
+		}
+
+		auto const& vertices = dijkstra.vertices_for(Target(target.first, vertical));
+		if (!vertices.empty()) {
+			// TODO: choose from multiple possible target vertices via
+			// to-be-introduced random seed
+			path = dijkstra.path_to(*(vertices.begin()));
+		}
+		paths.push_back(path);
+	}
+	return paths;
+}
+
+void L1Routing::commit(
+    DNCMergerOnWafer const& merger, targets_type const& targets, paths_type const& paths)
+{
+	auto const source = m_l1_graph[merger.toHICANNOnWafer()]
+	                              [merger.toSendingRepeaterOnHICANN().toHLineOnHICANN()];
+	PathBundle bundle;
+	auto path = paths.begin();
+	for (auto const& target : targets) {
+		if (store_result(request_type{merger, target.first, target.second}, source, *path)) {
+			bundle.add(*path);
+		}
+		++path;
+	}
+	m_l1_graph.remove(bundle);
+	m_reachability.update(bundle);
+	remember(merger, targets, paths);
+}
+
+void L1Routing::remember(
+    DNCMergerOnWafer const& merger, targets_type const& targets, paths_type const& paths)
+{
+	if (!m_route_cache) {
+		return;
+	}
+
+	std::map<HICANNOnWafer, PathBundle::path_type const*> sorted;
+	auto path = paths.begin();
+	for (auto const& target : targets) {
+		sorted[target.first] = &(*path);
+		++path;
+	}
+
+	L1RouteCache::targets_type cached_targets;
+	L1RouteCache::paths_type cached_paths;
+	cached_targets.reserve(sorted.size());
+	cached_paths.reserve(sorted.size());
+	for (auto const& item : sorted) {
+		cached_targets.push_back(item.first);
+		cached_paths.push_back(*item.second);
+	}
+	m_route_cache->insert(merger, cached_targets, cached_paths);
+}
+
+std::vector<DNCMergerOnWafer> L1Routing::replay_previous_routes(
+    std::vector<DNCMergerOnWafer> const& sources)
+{
+	auto const& drv_per_src = m_driver_requirements;
+
+	std::vector<DNCMergerOnWafer> remaining;
 	for (auto const& merger : sources) {
-		weights.set_weight(
-			m_l1_graph[merger.toHICANNOnWafer()]
-			          [merger.toSendingRepeaterOnHICANN().toHLineOnHICANN()],
-			10000); // TODO: magic number
+		if (m_reroute.count(merger)) {
+			remaining.push_back(merger);
+			continue;
+		}
+
+		auto const targets = drv_per_src.targets_for_source(merger);
+		paths_type paths;
+		paths.reserve(targets.size());
+		for (auto const& target : targets) {
+			PathBundle::path_type path;
+			for (auto const& item : m_previous->find_routes_from(merger)) {
+				if (item.target() == target.first) {
+					path = to_path(item.route());
+					break;
+				}
+			}
+			paths.push_back(path);
+		}
+
+		if (collides(paths)) {
+			MAROCCO_TRACE("not keeping previous routes of " << merger);
+			remaining.push_back(merger);
+			continue;
+		}
+
+		auto const source = m_l1_graph[merger.toHICANNOnWafer()]
+		                              [merger.toSendingRepeaterOnHICANN().toHLineOnHICANN()];
+		PathBundle bundle;
+		auto path = paths.begin();
+		for (auto const& target : targets) {
+			request_type const request{merger, target.first, target.second};
+			if (path->empty()) {
+				// Failure has already been reported in the previous run.
+				m_failed.push_back(request);
+			} else if (store_result(request, source, *path)) {
+				bundle.add(*path);
+			}
+			++path;
+		}
+		m_l1_graph.remove(bundle);
+		m_reachability.update(bundle);
 	}
-	auto const drv_per_src =
-	    SynapseDriverRequirementPerSource(m_bio_graph.graph(), m_neuron_placement);
+
+	MAROCCO_DEBUG(
+	    "kept previous routes of " << (sources.size() - remaining.size()) << " of "
+	                               << sources.size() << " sources");
+	return remaining;
+}
+
+PathBundle::path_type L1Routing::to_path(L1Route const& route) const
+{
+	PathBundle::path_type path;
+	HICANNOnWafer const* hicann = nullptr;
+	for (auto const& segment : route) {
+		if (auto const* next = boost::get<HICANNOnWafer>(&segment)) {
+			hicann = next;
+			if (!m_l1_graph.has(*hicann)) {
+				return PathBundle::path_type();
+			}
+		} else if (auto const* hline = boost::get<HLineOnHICANN>(&segment)) {
+			path.push_back(m_l1_graph[*hicann][*hline]);
+		} else if (auto const* vline = boost::get<VLineOnHICANN>(&segment)) {
+			path.push_back(m_l1_graph[*hicann][*vline]);
+		}
+	}
+	return path;
+}
+
+std::vector<DNCMergerOnWafer> L1Routing::replay_cached_routes(
+    std::vector<DNCMergerOnWafer> const& sources)
+{
+	auto const& drv_per_src = m_driver_requirements;
+
+	// Cached routes may have been calculated for a different set of sources and could
+	// block the sending repeaters of sources that are routed now.
+	auto const buses = sending_repeater_buses(sources);
+	std::unordered_set<L1RoutingGraph::vertex_descriptor> const sending_repeaters(
+	    buses.begin(), buses.end());
+
+	std::vector<DNCMergerOnWafer> remaining;
 	for (auto const& merger : sources) {
 		auto const source = m_l1_graph[merger.toHICANNOnWafer()]
 		                              [merger.toSendingRepeaterOnHICANN().toHLineOnHICANN()];
 		auto const targets = drv_per_src.targets_for_source(merger);
 
-		MAROCCO_TRACE("routing from " << merger << " to " << targets.size() << " targets");
+		std::map<HICANNOnWafer, size_t> index;
+		for (auto const& target : targets) {
+			index.insert(std::make_pair(target.first, index.size()));
+		}
+		L1RouteCache::targets_type sorted_targets;
+		sorted_targets.reserve(index.size());
+		for (auto const& item : index) {
+			sorted_targets.push_back(item.first);
+		}
 
-		L1DijkstraRouter dijkstra(weights, source);
+		auto const* cached = m_route_cache->find(merger, sorted_targets);
+		if (cached == nullptr) {
+			remaining.push_back(merger);
+			continue;
+		}
 
-		for (auto const& target : targets) {
-			dijkstra.add_target(Target(target.first, vertical));
+		// Bring paths into iteration order of targets.
+		paths_type paths(targets.size());
+		bool complete = true;
+		auto path = cached->begin();
+		for (auto const& item : index) {
+			complete = complete && !path->empty() && path->front() == source;
+			paths[item.second] = *path;
+			++path;
 		}
 
-		dijkstra.run();
+		// Previously failed routes are searched for again, as resources may have been freed.
+		if (!complete || collides(paths) ||
+		    crosses_sending_repeater_buses(paths, sending_repeaters)) {
+			MAROCCO_TRACE("not replaying cached routes of " << merger);
+			remaining.push_back(merger);
+			continue;
+		}
 
-		PathBundle bundle;
-		for (auto const& target : targets) {
-			auto const& vertices = dijkstra.vertices_for(Target(target.first, vertical));
+		MAROCCO_TRACE("replaying cached routes of " << merger);
+		commit(merger, targets, paths);
+	}
 
-			PathBundle::path_type path;
-			if (!vertices.empty()) {
-				// TODO: choose from multiple possible target vertices via
-				// to-be-introduced random seed
-				path = dijkstra.path_to(*(vertices.begin()));
+	MAROCCO_INFO(
+	    "Replayed cached L1 routes of " << (sources.size() - remaining.size()) << " of "
+	                                    << sources.size() << " sources");
+	return remaining;
+}
+
+bool L1Routing::collides(paths_type const& paths) const
+{
+	for (auto const& path : paths) {
+		for (auto const& vertex : path) {
+			if (m_l1_graph.is_removed(vertex)) {
+				return true;
 			}
+		}
+	}
+	return false;
+}
 
-			if (store_result(request_type{merger, target.first, target.second}, source, path)) {
-				bundle.add(path);
+void L1Routing::run_dijkstra_router(std::vector<DNCMergerOnWafer> const& sources)
+{
+	MAROCCO_INFO("Beginning L1 routing using dijkstra router");
+	L1EdgeWeights weights(m_l1_graph.graph());
+
+	// Avoid horizontal buses belonging to used sending repeaters.
+	weights.set_weights(sending_repeater_buses(sources), sending_repeater_penalty);
+	auto const& drv_per_src = m_driver_requirements;
+
+	size_t const batch_size = m_parameters.speculative_batch_size();
+	tbb::enumerable_thread_specific<RoutingWorkspace> workspaces;
+	size_t n_rerouted = 0;
+
+	for (size_t begin = 0; begin < sources.size(); begin += batch_size) {
+		size_t const end = std::min(sources.size(), begin + batch_size);
+
+		std::vector<targets_type> targets;
+		targets.reserve(end - begin);
+		for (size_t ii = begin; ii < end; ++ii) {
+			targets.push_back(drv_per_src.targets_for_source(sources[ii]));
+		}
+
+		std::vector<paths_type> speculative(end - begin);
+		if (end - begin > 1) {
+			// Make sure the storage of the routing graph is up to date before it is
+			// accessed concurrently.
+			m_l1_graph.graph();
+
+			tbb::parallel_for(
+			    tbb::blocked_range<size_t>(begin, end),
+			    [&](tbb::blocked_range<size_t> const& range) {
+				    auto& workspace = workspaces.local();
+				    for (size_t ii = range.begin(); ii != range.end(); ++ii) {
+					    speculative[ii - begin] = route_with_dijkstra(
+					        weights, sources[ii], targets[ii - begin], workspace);
+				    }
+			    });
+		}
+
+		// Commit in order of priority.  The first source of each batch never collides, as
+		// its routes have been calculated on the current state of the routing graph.
+		for (size_t ii = begin; ii < end; ++ii) {
+			auto& paths = speculative[ii - begin];
+			if (end - begin == 1) {
+				paths = route_with_dijkstra(weights, sources[ii], targets[ii - begin], m_workspace);
+			} else if (collides(paths)) {
+				MAROCCO_TRACE("re-routing " << sources[ii] << " because of conflicts");
+				paths = route_with_dijkstra(weights, sources[ii], targets[ii - begin], m_workspace);
+				++n_rerouted;
 			}
+			commit(sources[ii], targets[ii - begin], paths);
 		}
-		m_l1_graph.remove(bundle);
 	}
+
+	if (batch_size > 1) {
+		MAROCCO_DEBUG(
+		    "re-routed " << n_rerouted << " of " << sources.size()
+		                 << " sources because of conflicts in speculative routing");
+	}
+}
+
+void L1Routing::run_negotiated_congestion_router(std::vector<DNCMergerOnWafer> const& sources)
+{
+	MAROCCO_INFO("Beginning L1 routing using negotiated congestion router");
+	typedef L1RoutingGraph::vertex_descriptor vertex_descriptor;
+	typedef L1EdgeWeights::weight_type weight_type;
+
+	auto const& graph = m_l1_graph.graph();
+	size_t const num_vertices = boost::num_vertices(graph);
+
+	// Costs of buses are scaled by `base_cost` to be able to represent fractional
+	// congestion penalties by integral weights.
+	weight_type const base_cost = 10;
+	weight_type const sending_repeater_cost = sending_repeater_penalty * base_cost;
+	// Cost of each bus is (1 + history) × (1 + present_factor × occupancy), where history
+	// grows for buses that are congested after an iteration and present_factor grows
+	// with each iteration, cf. PathFinder (McMurchie and Ebeling, 1995).
+	double const history_increment = 1.;
+	double const initial_present_factor = 0.5;
+	double const present_factor_growth = 1.5;
+
+	boost::dynamic_bitset<> is_sending_repeater(num_vertices);
+	auto const sending_repeaters = sending_repeater_buses(sources);
+	for (auto const vertex : sending_repeaters) {
+		is_sending_repeater.set(vertex);
+	}
+
+	// Number of sources currently using each bus.
+	std::vector<size_t> occupancy(num_vertices, 0);
+	std::vector<double> history(num_vertices, 0.);
+	double present_factor = initial_present_factor;
+
+	L1EdgeWeights weights(graph);
+	auto const update_weight = [&](vertex_descriptor const vertex) {
+		double const cost = static_cast<double>(base_cost) * (1. + history[vertex]) *
+		                    (1. + present_factor * occupancy[vertex]);
+		weight_type weight = static_cast<weight_type>(
+		    std::min(std::ceil(cost), static_cast<double>(L1EdgeWeights::max_weight())));
+		if (is_sending_repeater.test(vertex)) {
+			weight = std::max(weight, sending_repeater_cost);
+		}
+		weights.set_weight(vertex, weight);
+	};
+	for (vertex_descriptor vertex = 0; vertex < num_vertices; ++vertex) {
+		update_weight(vertex);
+	}
+
+	auto const& drv_per_src = m_driver_requirements;
+	std::vector<targets_type> targets;
+	targets.reserve(sources.size());
+	for (auto const& merger : sources) {
+		targets.push_back(drv_per_src.targets_for_source(merger));
+	}
+
+	std::vector<paths_type> routes(sources.size());
+	// Buses used by the routes of each source, without duplicates.
+	std::vector<std::vector<vertex_descriptor> > used_buses(sources.size());
+
+	size_t const max_iterations = m_parameters.negotiated_congestion_iterations();
+	for (size_t iteration = 0; iteration < max_iterations; ++iteration) {
+		for (size_t ii = 0; ii < sources.size(); ++ii) {
+			// Rip up routes of this source and route again using current costs.
+			for (auto const vertex : used_buses[ii]) {
+				--occupancy[vertex];
+				update_weight(vertex);
+			}
+
+			routes[ii] = route_with_dijkstra(weights, sources[ii], targets[ii], m_workspace);
+
+			auto& buses = used_buses[ii];
+			buses.clear();
+			for (auto const& path : routes[ii]) {
+				buses.insert(buses.end(), path.begin(), path.end());
+			}
+			std::sort(buses.begin(), buses.end());
+			buses.erase(std::unique(buses.begin(), buses.end()), buses.end());
+
+			for (auto const vertex : buses) {
+				++occupancy[vertex];
+				update_weight(vertex);
+			}
+		}
+
+		size_t n_congested = 0;
+		for (vertex_descriptor vertex = 0; vertex < num_vertices; ++vertex) {
+			if (occupancy[vertex] > 1) {
+				++n_congested;
+				history[vertex] += history_increment * (occupancy[vertex] - 1);
+			}
+		}
+
+		MAROCCO_DEBUG(
+		    "negotiated congestion iteration " << iteration << ": " << n_congested
+		                                       << " congested L1 buses");
+		if (n_congested == 0) {
+			break;
+		}
+
+		present_factor *= present_factor_growth;
+		for (vertex_descriptor vertex = 0; vertex < num_vertices; ++vertex) {
+			update_weight(vertex);
+		}
+	}
+
+	// Commit in order of priority.  If congestion could not be resolved, sources using
+	// buses that have already been committed are routed greedily on the remaining graph.
+	L1EdgeWeights greedy_weights(graph);
+	greedy_weights.set_weights(sending_repeaters, sending_repeater_penalty);
+	size_t n_rerouted = 0;
+	for (size_t ii = 0; ii < sources.size(); ++ii) {
+		if (collides(routes[ii])) {
+			MAROCCO_TRACE("re-routing " << sources[ii] << " because of remaining congestion");
+			routes[ii] =
+			    route_with_dijkstra(greedy_weights, sources[ii], targets[ii], m_workspace);
+			++n_rerouted;
+		}
+		commit(sources[ii], targets[ii], routes[ii]);
+	}
+
+	if (n_rerouted != 0) {
+		MAROCCO_DEBUG(
+		    "re-routed " << n_rerouted << " of " << sources.size()
+		                 << " sources greedily because of remaining congestion");
+	}
+}
+
+void L1Routing::run_steiner_router(std::vector<DNCMergerOnWafer> const& sources)
+{
+	MAROCCO_INFO("Beginning L1 routing using steiner router");
+	L1EdgeWeights weights(m_l1_graph.graph());
+
+	// Avoid horizontal buses belonging to used sending repeaters.
+	weights.set_weights(sending_repeater_buses(sources), sending_repeater_penalty);
+	auto const& drv_per_src = m_driver_requirements;
+
+	for (auto const& merger : sources) {
+		auto const targets = drv_per_src.targets_for_source(merger);
+		commit(merger, targets, route_with_steiner(weights, merger, targets));
+	}
+}
+
+void L1Routing::run_hierarchical_router(std::vector<DNCMergerOnWafer> const& sources)
+{
+	MAROCCO_INFO("Beginning L1 routing using hierarchical router");
+	L1EdgeWeights weights(m_l1_graph.graph());
+
+	// Avoid horizontal buses belonging to used sending repeaters.
+	weights.set_weights(sending_repeater_buses(sources), sending_repeater_penalty);
+	auto const& drv_per_src = m_driver_requirements;
+
+	// Coarse pass: plan the corridors of all sources on the HICANN grid, in order of
+	// priority, so that later sources are steered around congested connections.
+	L1CorridorPlanner planner(m_l1_graph, m_parameters.corridor_margin());
+	std::vector<targets_type> targets;
+	std::vector<RoutingRegion> corridors;
+	targets.reserve(sources.size());
+	corridors.reserve(sources.size());
+	for (auto const& merger : sources) {
+		targets.push_back(drv_per_src.targets_for_source(merger));
+		std::vector<HICANNOnWafer> target_hicanns;
+		target_hicanns.reserve(targets.back().size());
+		for (auto const& target : targets.back()) {
+			target_hicanns.push_back(target.first);
+		}
+		corridors.push_back(planner.plan(merger.toHICANNOnWafer(), target_hicanns));
+	}
+
+	// Detailed pass: route each source within its corridor.  Corridors do not account
+	// for the detailed state of the routing graph, so sources with targets that could
+	// not be reached within their corridor are routed again without restriction.
+	size_t n_fallback = 0;
+	for (size_t ii = 0; ii < sources.size(); ++ii) {
+		auto paths =
+		    route_with_dijkstra(weights, sources[ii], targets[ii], m_workspace, corridors[ii]);
+		bool const incomplete = std::any_of(
+		    paths.begin(), paths.end(),
+		    [](PathBundle::path_type const& path) { return path.empty(); });
+		if (incomplete) {
+			MAROCCO_TRACE("re-routing " << sources[ii] << " outside of its corridor");
+			paths = route_with_dijkstra(weights, sources[ii], targets[ii], m_workspace);
+			++n_fallback;
+		}
+		commit(sources[ii], targets[ii], paths);
+	}
+
+	MAROCCO_DEBUG(
+	    "re-routed " << n_fallback << " of " << sources.size()
+	                 << " sources outside of their corridor");
+}
+
+auto L1Routing::route_with_steiner(
+    L1EdgeWeights const& weights, DNCMergerOnWafer const& merger, targets_type const& targets)
+    -> paths_type
+{
+	auto const& graph = m_l1_graph.graph();
+	auto const source = m_l1_graph[merger.toHICANNOnWafer()]
+	                              [merger.toSendingRepeaterOnHICANN().toHLineOnHICANN()];
+
+	MAROCCO_TRACE("routing from " << merger << " to " << targets.size() << " targets");
+
+	L1SteinerRouter steiner(
+	    weights, source,
+	    [this, &graph](L1RoutingGraph::vertex_descriptor const vertex) {
+		    return m_resource_manager.getMaxL1Crossbars(graph[vertex]);
+	    },
+	    m_workspace);
+
+	// Unreachable targets are not searched for.
+	std::vector<bool> reachable;
+	reachable.reserve(targets.size());
+	for (auto const& target : targets) {
+		Target const target_(target.first, vertical);
+		reachable.push_back(m_reachability.reachable(source, target_));
+		if (reachable.back()) {
+			steiner.add_target(target_);
+		} else {
+			MAROCCO_TRACE("skipping unreachable target " << target.first);
+		}
+	}
+
+	if (std::find(reachable.begin(), reachable.end(), true) != reachable.end()) {
+		steiner.run();
+	}
+
+	paths_type paths;
+	paths.reserve(targets.size());
+	auto is_reachable = reachable.begin();
+	for (auto const& target : targets) {
+		if (*(is_reachable++)) {
+			paths.push_back(steiner.path_to(Target(target.first, vertical)));
+		} else {
+			paths.push_back(PathBundle::path_type());
+		}
+	}
+	return paths;
 }
 
 bool L1Routing::store_result(
@@ -241,6 +905,7 @@ bool L1Routing::store_result(
 		MAROCCO_WARN(
 			"could not establish route from " << request.source << " to " << request.target);
 		m_failed.push_back(request);
+		m_unreachable.insert(request.source);
 		return false;
 	}
 
@@ -253,6 +918,16 @@ bool L1Routing::store_result(
 	}
 
 	MAROCCO_TRACE("found route to " << request.target);
+
+	// L1 buses are used by a single source, which determines their event rate.
+	auto const rate = m_source_rates.find(request.source);
+	double const bus_rate = rate == m_source_rates.end() ? 0. : rate->second;
+	for (auto const& vertex : path) {
+		auto const& bus = m_l1_graph[vertex];
+		m_bus_rates[bus] = bus_rate;
+		m_result.set_predicted_rate(bus, bus_rate);
+	}
+
 	auto const route = with_dnc_merger_prefix(toL1Route(m_l1_graph.graph(), path), request.source);
 	MAROCCO_TRACE("route : \n" << route);
 	auto const& item = m_result.add(route, request.target);
@@ -269,6 +944,22 @@ auto L1Routing::failed_routes() const -> std::vector<request_type> const&
 	return m_failed;
 }
 
+auto L1Routing::rejected_routes() const -> std::vector<request_type> const&
+{
+	return m_rejected;
+}
+
+auto L1Routing::sources_with_unreachable_targets() const
+    -> std::set<DNCMergerOnWafer> const&
+{
+	return m_unreachable;
+}
+
+auto L1Routing::predicted_bus_rates() const -> bus_rates_type const&
+{
+	return m_bus_rates;
+}
+
 L1Route toL1Route(PathBundle::graph_type const& graph, PathBundle::path_type const& path)
 {
 	assert(!path.empty());
@@ -336,10 +1027,27 @@ L1Route with_dnc_merger_prefix(L1Route const& route, DNCMergerOnWafer const& mer
 	return result;
 }
 
+bool crosses_sending_repeater_buses(
+    std::vector<PathBundle::path_type> const& paths,
+    std::unordered_set<L1RoutingGraph::vertex_descriptor> const& sending_repeater_buses)
+{
+	for (auto const& path : paths) {
+		if (path.empty()) {
+			continue;
+		}
+		for (auto it = std::next(path.begin()); it != path.end(); ++it) {
+			if (sending_repeater_buses.count(*it)) {
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
 std::vector<L1RoutingGraph::vertex_descriptor> L1_crossbar_restrictioning(
     L1RoutingGraph::vertex_descriptor const& switch_from,
     std::vector<L1RoutingGraph::vertex_descriptor> const& switch_to_candidates,
-    std::vector<L1RoutingGraph::vertex_descriptor> const& predecessors,
+    RoutingWorkspace const& workspace,
     boost::optional<resource::HICANNManager&> res_mgr,
     L1RoutingGraph::graph_type const& l1_graph)
 {
@@ -348,7 +1056,8 @@ std::vector<L1RoutingGraph::vertex_descriptor> L1_crossbar_restrictioning(
 	std::vector<L1RoutingGraph::vertex_descriptor> expect_switching_to;
 
 	for (auto candidate : switch_to_candidates) {
-		if (predecessors[candidate] == switch_from || predecessors[switch_from] == candidate) {
+		if (workspace.predecessor(candidate) == switch_from ||
+		    workspace.predecessor(switch_from) == candidate) {
 			// we found a planned connection between switch_from and this candidate.
 			// thus we save it as an expected swtich.
 			expect_switching_to.push_back(candidate);
@@ -2,6 +2,7 @@
 
 #include <set>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include <boost/optional.hpp>
@@ -14,8 +15,15 @@
 #include "marocco/coordinates/L1RouteTree.h"
 #include "marocco/placement/results/Placement.h"
 #include "marocco/resource/Manager.h"
+#include "marocco/routing/L1BusOnWafer.h"
+#include "marocco/routing/L1EdgeWeights.h"
+#include "marocco/routing/L1ReachabilityIndex.h"
+#include "marocco/routing/L1RouteCache.h"
 #include "marocco/routing/L1RoutingGraph.h"
 #include "marocco/routing/PathBundle.h"
+#include "marocco/routing/RoutingRegion.h"
+#include "marocco/routing/RoutingWorkspace.h"
+#include "marocco/routing/SynapseDriverRequirementPerSource.h"
 #include "marocco/routing/parameters/L1Routing.h"
 #include "marocco/routing/results/L1Routing.h"
 
@@ -26,6 +34,8 @@ class L1Routing {
 public:
 	typedef std::unordered_map<halco::hicann::v2::HICANNOnWafer, std::set<BioGraph::edge_descriptor> >
 		targets_type;
+	/// Predicted event rates in Hz (hardware time).
+	typedef std::unordered_map<L1BusOnWafer, double> bus_rates_type;
 
 	struct request_type
 	{
@@ -40,7 +50,21 @@ public:
 	    parameters::L1Routing const& parameters,
 	    placement::results::Placement const& neuron_placement,
 	    results::L1Routing& result,
-	    resource::HICANNManager& resource_manager);
+	    resource::HICANNManager& resource_manager,
+	    double speedup,
+	    boost::optional<L1RouteCache&> route_cache = boost::none);
+
+	/**
+	 * @brief Keeps the routes of a previous run on a smaller routing graph.
+	 * All sources but the given ones reuse their previous routes instead of being routed
+	 * again.  Targets that could not be reached previously are reported as failed.
+	 * @param previous Result of the previous run, which has to stay valid during run().
+	 * @param reroute Sources to route again.
+	 * @note Has to be called before run().
+	 */
+	void keep_routes(
+	    results::L1Routing const& previous,
+	    std::set<halco::hicann::v2::DNCMergerOnWafer> const& reroute);
 
 	/**
 	 * @brief Run routing algorithm.
@@ -54,11 +78,137 @@ public:
 	 */
 	std::vector<halco::hicann::v2::DNCMergerOnWafer> sources_sorted_by_priority() const;
 
+	/**
+	 * @brief Returns the requests for which no route could be established.
+	 * Requests rejected because of the bus rate budget are not included.
+	 * @see rejected_routes()
+	 */
 	std::vector<request_type> const& failed_routes() const;
 
+	/**
+	 * @brief Returns the requests that were not routed as their source exceeds the
+	 *        enforced bus rate budget.
+	 */
+	std::vector<request_type> const& rejected_routes() const;
+
+	/**
+	 * @brief Returns the sources with targets that could not be reached, as no free path
+	 *        was left in the routing graph.
+	 * Only these routes can benefit from a larger routing graph.
+	 */
+	std::set<halco::hicann::v2::DNCMergerOnWafer> const& sources_with_unreachable_targets()
+	    const;
+
+	/**
+	 * @brief Returns the predicted event rate of each L1 bus used by established routes.
+	 * @see parameters::L1Routing::bus_rate_budget()
+	 */
+	bus_rates_type const& predicted_bus_rates() const;
+
 private:
-	void run_backbone_router();
-	void run_dijkstra_router();
+	/// Paths to the targets of a single source, in iteration order of its targets.
+	typedef std::vector<PathBundle::path_type> paths_type;
+
+	void run_backbone_router(std::vector<halco::hicann::v2::DNCMergerOnWafer> const& sources);
+	void run_dijkstra_router(std::vector<halco::hicann::v2::DNCMergerOnWafer> const& sources);
+	void run_negotiated_congestion_router(
+	    std::vector<halco::hicann::v2::DNCMergerOnWafer> const& sources);
+	void run_steiner_router(std::vector<halco::hicann::v2::DNCMergerOnWafer> const& sources);
+	void run_hierarchical_router(
+	    std::vector<halco::hicann::v2::DNCMergerOnWafer> const& sources);
+
+	/**
+	 * @brief Estimates the event rate of each source from its spike sources.
+	 * Firing rates of hardware neurons are not known in advance and are not included.
+	 */
+	std::unordered_map<halco::hicann::v2::DNCMergerOnWafer, double> estimate_source_rates() const;
+
+	/**
+	 * @brief Checks the estimated event rates of the given sources against the bus rate
+	 *        budget.
+	 * @return Sources to be routed, in the original order.  If the budget is enforced,
+	 *         sources exceeding it are omitted and reported as failed routes.
+	 */
+	std::vector<halco::hicann::v2::DNCMergerOnWafer> apply_bus_rate_budget(
+	    std::vector<halco::hicann::v2::DNCMergerOnWafer> const& sources);
+
+	/**
+	 * @brief Logs a summary of the predicted bus rates of established routes.
+	 */
+	void report_bus_rates() const;
+
+	/**
+	 * @brief Commits the routes of a previous run for all sources that are not rerouted.
+	 * @return Sources to be rerouted, in the original order.
+	 * @see keep_routes()
+	 */
+	std::vector<halco::hicann::v2::DNCMergerOnWafer> replay_previous_routes(
+	    std::vector<halco::hicann::v2::DNCMergerOnWafer> const& sources);
+
+	/**
+	 * @brief Translates an L1 route into the corresponding vertices of the routing graph.
+	 * @return Path of buses or an empty path if the route uses buses not part of the graph.
+	 */
+	PathBundle::path_type to_path(L1Route const& route) const;
+
+	/**
+	 * @brief Commits cached routes of all sources whose buses are still available.
+	 * Sources are considered in the given order.  Sources with failed or conflicting
+	 * cached routes, or with cached routes passing the sending repeater of another of the
+	 * given sources, are left to the routing algorithm.
+	 * @return Sources without replayed routes, in the original order.
+	 */
+	std::vector<halco::hicann::v2::DNCMergerOnWafer> replay_cached_routes(
+	    std::vector<halco::hicann::v2::DNCMergerOnWafer> const& sources);
+
+	/**
+	 * @brief Adds the routes of a single source to the route cache, if present.
+	 */
+	void remember(
+	    halco::hicann::v2::DNCMergerOnWafer const& merger,
+	    targets_type const& targets,
+	    paths_type const& paths);
+
+	/**
+	 * @brief Returns the vertices of the horizontal buses driven by the given sources.
+	 */
+	std::vector<L1RoutingGraph::vertex_descriptor> sending_repeater_buses(
+	    std::vector<halco::hicann::v2::DNCMergerOnWafer> const& sources) const;
+
+	/**
+	 * @brief Calculates the paths from a single source to its targets.
+	 * @param region If given, the search is restricted to buses of these HICANNs.
+	 * @note This only reads the routing graph and can be called concurrently.
+	 */
+	paths_type route_with_dijkstra(
+	    L1EdgeWeights const& weights,
+	    halco::hicann::v2::DNCMergerOnWafer const& merger,
+	    targets_type const& targets,
+	    RoutingWorkspace& workspace,
+	    boost::optional<RoutingRegion const&> region = boost::none) const;
+
+	/**
+	 * @brief Calculates a route tree from a single source to its targets.
+	 */
+	paths_type route_with_steiner(
+	    L1EdgeWeights const& weights,
+	    halco::hicann::v2::DNCMergerOnWafer const& merger,
+	    targets_type const& targets);
+
+	/**
+	 * @brief Stores the results for a single source and removes the used buses from the
+	 *        routing graph.
+	 */
+	void commit(
+	    halco::hicann::v2::DNCMergerOnWafer const& merger,
+	    targets_type const& targets,
+	    paths_type const& paths);
+
+	/**
+	 * @brief Checks whether any of the given paths uses an already removed bus.
+	 */
+	bool collides(paths_type const& paths) const;
+
 	bool store_result(
 		request_type const& request,
 	    L1RoutingGraph::vertex_descriptor const source,
@@ -70,7 +220,22 @@ private:
 	placement::results::Placement const& m_neuron_placement;
 	results::L1Routing& m_result;
 	std::vector<request_type> m_failed;
+	std::vector<request_type> m_rejected;
+	std::set<halco::hicann::v2::DNCMergerOnWafer> m_unreachable;
 	resource::HICANNManager& m_resource_manager;
+	double m_speedup;
+	boost::optional<L1RouteCache&> m_route_cache;
+	boost::optional<results::L1Routing const&> m_previous;
+	std::set<halco::hicann::v2::DNCMergerOnWafer> m_reroute;
+	/// Shared by all routing stages, so synapse driver requirements are only computed
+	/// once per source.
+	SynapseDriverRequirementPerSource const m_driver_requirements;
+	/// Shared by the routers of all sources to avoid per-source allocations.
+	RoutingWorkspace m_workspace;
+	/// Used to skip targets that cannot be reached anymore.
+	L1ReachabilityIndex m_reachability;
+	std::unordered_map<halco::hicann::v2::DNCMergerOnWafer, double> m_source_rates;
+	bus_rates_type m_bus_rates;
 }; // L1Routing
 
 /**
@@ -90,12 +255,21 @@ L1RouteTree toL1RouteTree(PathBundle::graph_type const& graph, PathBundle const&
 L1Route with_dnc_merger_prefix(
     L1Route const& route, halco::hicann::v2::DNCMergerOnWafer const& merger);
 
+/**
+ * @brief Checks whether any path passes one of the given buses driven by sending repeaters.
+ * The first bus of each path is not considered, as it belongs to the source of the path.
+ * Such paths block the sending repeater of another source.
+ */
+bool crosses_sending_repeater_buses(
+    std::vector<PathBundle::path_type> const& paths,
+    std::unordered_set<L1RoutingGraph::vertex_descriptor> const& sending_repeater_buses);
+
 /**
  * @brief function to discard branching candidates if too many L1-crossbar-switches are going to be
  * set.
  * @param[in] switch_from : the source bus
  * @param[in] switch_to_candidates : vector of target buses to test
- * @param[in] predecessors : according to its content the decisions are made
+ * @param[in] workspace : predecessors stored in it are used to make the decisions
  * @param[in] res_mgr : the resource manager, used to load calibration for the L1Crossbar switches
  * @param[in] l1_graph : graph used to convert vertex_descriptors to L1BusOnWafer
  * @return : returns a vector with allowed target buses
@@ -103,7 +277,7 @@ L1Route with_dnc_merger_prefix(
 std::vector<L1RoutingGraph::vertex_descriptor> L1_crossbar_restrictioning(
     L1RoutingGraph::vertex_descriptor const& switch_from,
     std::vector<L1RoutingGraph::vertex_descriptor> const& switch_to_candidates,
-    std::vector<L1RoutingGraph::vertex_descriptor> const& predecessors,
+    RoutingWorkspace const& workspace,
     boost::optional<resource::HICANNManager&>
         res_mgr, // might load config, thus prevents the whole function from being const
     L1RoutingGraph::graph_type const& l1_graph);
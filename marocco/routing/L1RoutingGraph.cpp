@@ -4,6 +4,7 @@
 #include "halco/common/iter_all.h"
 #include "hal/HICANN/Crossbar.h"
 #include "marocco/routing/PathBundle.h"
+#include "marocco/util/iterable.h"
 
 namespace marocco {
 namespace routing {
@@ -11,22 +12,73 @@ namespace routing {
 using namespace halco::hicann::v2;
 using namespace halco::common;
 
+L1RoutingGraph::EdgeFilter::EdgeFilter() : m_graph(nullptr)
+{
+}
+
+L1RoutingGraph::EdgeFilter::EdgeFilter(L1RoutingGraph const& graph) : m_graph(&graph)
+{
+}
+
+L1RoutingGraph::L1RoutingGraph(parameters::L1Routing l1_routing_parameters)
+    : m_hicanns()
+    , m_l1_routing_parameters(l1_routing_parameters)
+    , m_random_engine_shuffle_switches(m_l1_routing_parameters.shuffle_switches_seed())
+    , m_vertices()
+    , m_edges()
+    , m_removed_vertices()
+    , m_removed_edges()
+    , m_storage()
+    , m_storage_outdated(false)
+    , m_graph(m_storage, EdgeFilter(*this))
+{
+}
+
+L1RoutingGraph::L1RoutingGraph(L1RoutingGraph const& other)
+    : m_hicanns(other.m_hicanns)
+    , m_l1_routing_parameters(other.m_l1_routing_parameters)
+    , m_random_engine_shuffle_switches(other.m_random_engine_shuffle_switches)
+    , m_vertices(other.m_vertices)
+    , m_edges(other.m_edges)
+    , m_removed_vertices(other.m_removed_vertices)
+    , m_removed_edges(other.m_removed_edges)
+    , m_storage(other.m_storage)
+    , m_storage_outdated(other.m_storage_outdated)
+    // The filtered view has to refer to the storage and masks of this instance.
+    , m_graph(m_storage, EdgeFilter(*this))
+{
+}
+
+L1RoutingGraph& L1RoutingGraph::operator=(L1RoutingGraph const& other)
+{
+	// m_graph is bound to this instance and thus not assigned.
+	m_hicanns = other.m_hicanns;
+	m_l1_routing_parameters = other.m_l1_routing_parameters;
+	m_random_engine_shuffle_switches = other.m_random_engine_shuffle_switches;
+	m_vertices = other.m_vertices;
+	m_edges = other.m_edges;
+	m_removed_vertices = other.m_removed_vertices;
+	m_removed_edges = other.m_removed_edges;
+	m_storage = other.m_storage;
+	m_storage_outdated = other.m_storage_outdated;
+	return *this;
+}
+
 L1RoutingGraph::HICANN::HICANN(
-    graph_type& graph,
+    std::vector<value_type>& vertices,
+    std::vector<std::pair<vertex_descriptor, vertex_descriptor> >& edges,
     HICANNOnWafer const& hicann,
     parameters::L1Routing::SwitchOrdering switch_ordering,
     std::default_random_engine& random_engine)
 {
 	for (auto hline : iter_all<HLineOnHICANN>()) {
-		vertex_descriptor vertex = add_vertex(graph);
-		m_horizontal[hline] = vertex;
-		graph[vertex] = L1BusOnWafer(hicann, hline);
+		m_horizontal[hline] = vertices.size();
+		vertices.push_back(L1BusOnWafer(hicann, hline));
 	}
 
 	for (auto vline : iter_all<VLineOnHICANN>()) {
-		vertex_descriptor vertex = add_vertex(graph);
-		m_vertical[vline] = vertex;
-		graph[vertex] = L1BusOnWafer(hicann, vline);
+		m_vertical[vline] = vertices.size();
+		vertices.push_back(L1BusOnWafer(hicann, vline));
 	}
 
 	std::vector<std::pair<vertex_descriptor, vertex_descriptor>> switches;
@@ -56,8 +108,18 @@ L1RoutingGraph::HICANN::HICANN(
 			throw std::runtime_error("Unknown switch ordering");
 	};
 
-	for (auto const& sw : switches) {
-		add_edge(sw.first, sw.second, graph);
+	edges.insert(edges.end(), switches.begin(), switches.end());
+}
+
+L1RoutingGraph::HICANN::HICANN(vertex_descriptor first_vertex)
+{
+	vertex_descriptor vertex = first_vertex;
+	for (auto hline : iter_all<HLineOnHICANN>()) {
+		m_horizontal[hline] = vertex++;
+	}
+
+	for (auto vline : iter_all<VLineOnHICANN>()) {
+		m_vertical[vline] = vertex++;
 	}
 }
 
@@ -71,24 +133,70 @@ auto L1RoutingGraph::HICANN::operator[](VLineOnHICANN const& vline) const -> ver
 	return m_vertical[vline];
 }
 
-auto L1RoutingGraph::graph() -> graph_type&
+auto L1RoutingGraph::graph() const -> graph_type const&
 {
+	update_storage();
 	return m_graph;
 }
 
-auto L1RoutingGraph::graph() const -> graph_type const&
+auto L1RoutingGraph::storage() const -> storage_type const&
 {
-	return m_graph;
+	update_storage();
+	return m_storage;
 }
 
-auto L1RoutingGraph::operator[](vertex_descriptor vertex) -> value_type&
+void L1RoutingGraph::update_storage() const
 {
-	return m_graph[vertex];
+	if (!m_storage_outdated) {
+		return;
+	}
+
+	// Both directions of each undirected edge are stored as separate arcs.  As the
+	// construction of the storage preserves the order of arcs with common source, the out
+	// edges of each vertex are ordered by their time of creation (as was the case for
+	// the previously used adjacency list).
+	std::vector<std::pair<vertex_descriptor, vertex_descriptor> > arcs;
+	std::vector<edge_index_type> arc_properties;
+	arcs.reserve(2 * m_edges.size());
+	arc_properties.reserve(2 * m_edges.size());
+	for (edge_index_type index = 0; index < m_edges.size(); ++index) {
+		auto const& edge = m_edges[index];
+		arcs.push_back(edge);
+		arcs.push_back(std::make_pair(edge.second, edge.first));
+		arc_properties.push_back(index);
+		arc_properties.push_back(index);
+	}
+
+	m_storage = storage_type(
+	    boost::edges_are_unsorted_multi_pass, arcs.begin(), arcs.end(), arc_properties.begin(),
+	    m_vertices.size());
+
+	for (vertex_descriptor vertex = 0; vertex < m_vertices.size(); ++vertex) {
+		m_storage[vertex] = m_vertices[vertex];
+	}
+
+	m_storage_outdated = false;
+}
+
+bool L1RoutingGraph::is_removed(vertex_descriptor vertex) const
+{
+	return m_removed_vertices[vertex];
+}
+
+size_t L1RoutingGraph::num_edge_indices() const
+{
+	return m_edges.size();
+}
+
+auto L1RoutingGraph::edge_index(graph_type const& graph, edge_descriptor const& edge)
+    -> edge_index_type
+{
+	return graph[edge];
 }
 
 auto L1RoutingGraph::operator[](vertex_descriptor vertex) const -> value_type const&
 {
-	return m_graph[vertex];
+	return m_vertices[vertex];
 }
 
 auto L1RoutingGraph::operator[](HICANNOnWafer const& hicann) const -> HICANN const&
@@ -101,6 +209,11 @@ auto L1RoutingGraph::operator[](HICANNOnWafer const& hicann) const -> HICANN con
 	return it->second;
 }
 
+bool L1RoutingGraph::has(HICANNOnWafer const& hicann) const
+{
+	return m_hicanns.find(hicann) != m_hicanns.end();
+}
+
 auto L1RoutingGraph::operator[](value_type bus) const -> vertex_descriptor
 {
 	auto const& hicann = operator[](bus.toHICANNOnWafer());
@@ -123,7 +236,7 @@ bool L1RoutingGraph::connect(
 
 		for (auto line : iter_all<LineT>()) {
 			auto other_line = (line.*line_conv)();
-			add_edge(current[line], other[other_line], m_graph);
+			m_edges.push_back(std::make_pair(current[line], other[other_line]));
 		}
 
 		return true;
@@ -144,7 +257,7 @@ void L1RoutingGraph::add(HICANNOnWafer const& hicann)
 		bool success;
 		std::tie(std::ignore, success) = m_hicanns.insert(std::make_pair(
 		    hicann, HICANN(
-		                m_graph, hicann, m_l1_routing_parameters.switch_ordering(),
+		                m_vertices, m_edges, hicann, m_l1_routing_parameters.switch_ordering(),
 		                m_random_engine_shuffle_switches)));
 		if (!success) {
 			throw std::runtime_error("HICANN already present in graph");
@@ -156,15 +269,19 @@ void L1RoutingGraph::add(HICANNOnWafer const& hicann)
 	connect(hicann, &HICANNOnWafer::east, &HLineOnHICANN::east);
 	connect(hicann, &HICANNOnWafer::south, &VLineOnHICANN::south);
 	connect(hicann, &HICANNOnWafer::west, &HLineOnHICANN::west);
+
+	m_removed_vertices.resize(m_vertices.size());
+	m_removed_edges.resize(m_edges.size());
+	m_storage_outdated = true;
 }
 
 void L1RoutingGraph::remove(PathBundle const& bundle)
 {
-	// To keep the vertex descriptors intact we only use clear_vertex() to remove all
-	// edges connecting to a vertex instead of completely removing it from the graph.
+	// To keep the vertex descriptors intact, vertices are not removed from the graph.
+	// Instead all edges connecting to a vertex are hidden by marking it as removed.
 	for (auto const& path : bundle.paths()) {
 		for (vertex_descriptor const vertex : path) {
-			clear_vertex(vertex, m_graph);
+			m_removed_vertices.set(vertex);
 		}
 	}
 }
@@ -172,19 +289,67 @@ void L1RoutingGraph::remove(PathBundle const& bundle)
 void L1RoutingGraph::remove(
     halco::hicann::v2::HICANNOnWafer const& hicann, halco::hicann::v2::HLineOnHICANN const& hline)
 {
-	// See note on clear_vertex above.
-	clear_vertex(operator[](hicann)[hline], m_graph);
+	// See note on removed vertices above.
+	m_removed_vertices.set(operator[](hicann)[hline]);
 }
 
 void L1RoutingGraph::remove(
     halco::hicann::v2::HICANNOnWafer const& hicann, halco::hicann::v2::VLineOnHICANN const& vline)
 {
-	// See note on clear_vertex above.
-	clear_vertex(operator[](hicann)[vline], m_graph);
+	// See note on removed vertices above.
+	m_removed_vertices.set(operator[](hicann)[vline]);
 }
 
 void L1RoutingGraph::remove(
     halco::hicann::v2::HICANNOnWafer const& hicann, halco::hicann::v2::HRepeaterOnHICANN const& hrep)
+{
+	if (auto const edge = find_edge(hicann, hrep)) {
+		m_removed_edges.set(*edge);
+	}
+}
+
+void L1RoutingGraph::remove(
+    halco::hicann::v2::HICANNOnWafer const& hicann, halco::hicann::v2::VRepeaterOnHICANN const& vrep)
+{
+	if (auto const edge = find_edge(hicann, vrep)) {
+		m_removed_edges.set(*edge);
+	}
+}
+
+void L1RoutingGraph::remove(
+    halco::hicann::v2::HICANNOnWafer const& hicann,
+    halco::hicann::v2::CrossbarSwitchOnHICANN const& cs)
+{
+	if (auto const edge = find_edge(hicann, cs)) {
+		m_removed_edges.set(*edge);
+	}
+}
+
+void L1RoutingGraph::remove(DefectMask const& mask)
+{
+	if (&mask.m_graph != this || mask.m_vertices.size() != m_removed_vertices.size() ||
+	    mask.m_edges.size() != m_removed_edges.size()) {
+		throw std::invalid_argument("defect mask does not match routing graph");
+	}
+	m_removed_vertices |= mask.m_vertices;
+	m_removed_edges |= mask.m_edges;
+}
+
+auto L1RoutingGraph::find_edge(vertex_descriptor source, vertex_descriptor target) const
+    -> boost::optional<edge_index_type>
+{
+	update_storage();
+	for (auto const& edge : make_iterable(boost::out_edges(source, m_storage))) {
+		if (boost::target(edge, m_storage) == target) {
+			return m_storage[edge];
+		}
+	}
+	return boost::none;
+}
+
+auto L1RoutingGraph::find_edge(
+    halco::hicann::v2::HICANNOnWafer const& hicann,
+    halco::hicann::v2::HRepeaterOnHICANN const& hrep) const -> boost::optional<edge_index_type>
 {
 	auto hline = hrep.toHLineOnHICANN();
 	auto side = hrep.toSideHorizontal();
@@ -195,15 +360,16 @@ void L1RoutingGraph::remove(
 
 	auto it = m_hicanns.find(other_hicann);
 	if (it == m_hicanns.end()) {
-		return;
+		return boost::none;
 	}
 
 	auto other_vertex = it->second[other_hline];
-	remove_edge(vertex, other_vertex, m_graph);
+	return find_edge(vertex, other_vertex);
 }
 
-void L1RoutingGraph::remove(
-    halco::hicann::v2::HICANNOnWafer const& hicann, halco::hicann::v2::VRepeaterOnHICANN const& vrep)
+auto L1RoutingGraph::find_edge(
+    halco::hicann::v2::HICANNOnWafer const& hicann,
+    halco::hicann::v2::VRepeaterOnHICANN const& vrep) const -> boost::optional<edge_index_type>
 {
 	auto vline = vrep.toVLineOnHICANN();
 	auto side = vrep.toSideVertical();
@@ -214,22 +380,88 @@ void L1RoutingGraph::remove(
 
 	auto it = m_hicanns.find(other_hicann);
 	if (it == m_hicanns.end()) {
-		return;
+		return boost::none;
 	}
 
 	auto other_vertex = it->second[other_vline];
-	remove_edge(vertex, other_vertex, m_graph);
+	return find_edge(vertex, other_vertex);
 }
 
-void L1RoutingGraph::remove(
+auto L1RoutingGraph::find_edge(
     halco::hicann::v2::HICANNOnWafer const& hicann,
-    halco::hicann::v2::CrossbarSwitchOnHICANN const& cs)
+    halco::hicann::v2::CrossbarSwitchOnHICANN const& cs) const -> boost::optional<edge_index_type>
 {
 	halco::hicann::v2::VLineOnHICANN vline(cs.x());
 	halco::hicann::v2::HLineOnHICANN hline(cs.y());
 	auto vertex = operator[](hicann)[vline];
 	auto other_vertex = operator[](hicann)[hline];
-	remove_edge(vertex, other_vertex, m_graph);
+	return find_edge(vertex, other_vertex);
+}
+
+L1RoutingGraph::DefectMask::Counts::Counts() :
+    hbuses(0), hrepeaters(0), vbuses(0), vrepeaters(0), crossbar_switches(0)
+{
+}
+
+L1RoutingGraph::DefectMask::DefectMask(L1RoutingGraph const& graph) :
+    m_graph(graph),
+    m_vertices(graph.m_removed_vertices.size()),
+    m_edges(graph.m_removed_edges.size()),
+    m_counts()
+{
+	// Make sure edges can be looked up without rebuilding the storage.
+	m_graph.update_storage();
+}
+
+void L1RoutingGraph::DefectMask::disable(
+    halco::hicann::v2::HICANNOnWafer const& hicann, halco::hicann::v2::HLineOnHICANN const& hline)
+{
+	disable_vertex(m_graph[hicann][hline], m_counts.hbuses);
+}
+
+void L1RoutingGraph::DefectMask::disable(
+    halco::hicann::v2::HICANNOnWafer const& hicann, halco::hicann::v2::VLineOnHICANN const& vline)
+{
+	disable_vertex(m_graph[hicann][vline], m_counts.vbuses);
+}
+
+void L1RoutingGraph::DefectMask::disable(
+    halco::hicann::v2::HICANNOnWafer const& hicann, halco::hicann::v2::HRepeaterOnHICANN const& hrep)
+{
+	disable_edge(m_graph.find_edge(hicann, hrep), m_counts.hrepeaters);
+}
+
+void L1RoutingGraph::DefectMask::disable(
+    halco::hicann::v2::HICANNOnWafer const& hicann, halco::hicann::v2::VRepeaterOnHICANN const& vrep)
+{
+	disable_edge(m_graph.find_edge(hicann, vrep), m_counts.vrepeaters);
+}
+
+void L1RoutingGraph::DefectMask::disable(
+    halco::hicann::v2::HICANNOnWafer const& hicann,
+    halco::hicann::v2::CrossbarSwitchOnHICANN const& cs)
+{
+	disable_edge(m_graph.find_edge(hicann, cs), m_counts.crossbar_switches);
+}
+
+auto L1RoutingGraph::DefectMask::counts() const -> Counts const&
+{
+	return m_counts;
+}
+
+void L1RoutingGraph::DefectMask::disable_vertex(vertex_descriptor vertex, size_t& counter)
+{
+	if (!m_vertices.test_set(vertex)) {
+		++counter;
+	}
+}
+
+void L1RoutingGraph::DefectMask::disable_edge(
+    boost::optional<edge_index_type> const& edge, size_t& counter)
+{
+	if (edge && !m_edges.test_set(*edge)) {
+		++counter;
+	}
 }
 
 } // namespace routing
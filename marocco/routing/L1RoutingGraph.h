@@ -2,8 +2,11 @@
 
 #include <random>
 
+#include <boost/dynamic_bitset.hpp>
 #include <boost/functional/hash.hpp>
-#include <boost/graph/adjacency_list.hpp>
+#include <boost/graph/compressed_sparse_row_graph.hpp>
+#include <boost/graph/filtered_graph.hpp>
+#include <boost/optional.hpp>
 #include <unordered_map>
 
 #include "halco/hicann/v2/hicann.h"
@@ -17,33 +20,91 @@ namespace marocco {
 namespace routing {
 
 class PathBundle;
+class L1RoutingGraphCache;
 
 /**
  * @brief Representation of the layer 1 routing of a single wafer.
+ * The connectivity of all added HICANNs is stored in an immutable compressed sparse row
+ * graph, which is (re-)built on demand when accessing #graph() after HICANNs have been
+ * added.  Removing buses (e.g. because they have been used for a route) or connections
+ * (e.g. because of defects) does not modify the structure of this graph but is recorded
+ * in per-vertex and per-edge bitmasks.  The graph returned by #graph() is a filtered view
+ * that hides all edges which have been removed or which are incident to a removed vertex.
  */
 class L1RoutingGraph
 {
 public:
-	L1RoutingGraph(parameters::L1Routing l1_routing_parameters = parameters::L1Routing())
-	    : m_l1_routing_parameters(l1_routing_parameters)
-	    , m_random_engine_shuffle_switches(m_l1_routing_parameters.shuffle_switches_seed())
-	{}
-
 	typedef L1BusOnWafer value_type;
-	typedef boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS, value_type>
-	    graph_type;
+
+	/**
+	 * @brief Index of an undirected connection between two L1 buses.
+	 * This is shared by both directed arcs used to store the connection.
+	 */
+	typedef size_t edge_index_type;
+
+	/**
+	 * @brief Underlying storage of the routing graph.
+	 * Each undirected connection is represented by two directed arcs, which carry the
+	 * index of the connection as edge property.
+	 */
+	typedef boost::compressed_sparse_row_graph<boost::directedS, value_type, edge_index_type>
+	    storage_type;
+
+	/**
+	 * @brief Edge predicate used to hide removed elements from the routing graph.
+	 */
+	class EdgeFilter
+	{
+	public:
+		EdgeFilter();
+		EdgeFilter(L1RoutingGraph const& graph);
+
+		bool operator()(storage_type::edge_descriptor const& edge) const
+		{
+			return m_graph->is_enabled(edge);
+		}
+
+	private:
+		L1RoutingGraph const* m_graph;
+	}; // EdgeFilter
+
+	typedef boost::filtered_graph<storage_type, EdgeFilter> graph_type;
 	typedef graph_type::vertex_descriptor vertex_descriptor;
 	typedef graph_type::edge_descriptor edge_descriptor;
 
+	L1RoutingGraph(parameters::L1Routing l1_routing_parameters = parameters::L1Routing());
+	L1RoutingGraph(L1RoutingGraph const& other);
+	L1RoutingGraph& operator=(L1RoutingGraph const& other);
+
 	class HICANN
 	{
 	public:
+		/**
+		 * @brief Number of vertices of each HICANN.
+		 * These are created consecutively, horizontal buses first.
+		 */
+		static size_t const num_vertices =
+		    halco::hicann::v2::HLineOnHICANN::size + halco::hicann::v2::VLineOnHICANN::size;
+
+		/**
+		 * @brief Creates the vertices and crossbar switch edges of a single HICANN.
+		 * @param vertices Property of each vertex of the routing graph, new vertices are
+		 *                 appended.
+		 * @param edges Undirected edges of the routing graph, new edges are appended.
+		 */
 		HICANN(
-		    graph_type& graph,
+		    std::vector<value_type>& vertices,
+		    std::vector<std::pair<vertex_descriptor, vertex_descriptor> >& edges,
 		    halco::hicann::v2::HICANNOnWafer const& hicann,
 		    parameters::L1Routing::SwitchOrdering switch_ordering,
 		    std::default_random_engine& random_engine);
 
+		/**
+		 * @brief Restores the lookup of vertices that have been created by the other
+		 *        constructor, starting at the given vertex.
+		 */
+		HICANN(vertex_descriptor first_vertex);
+
 		vertex_descriptor operator[](halco::hicann::v2::HLineOnHICANN const& hline) const;
 		vertex_descriptor operator[](halco::hicann::v2::VLineOnHICANN const& vline) const;
 
@@ -54,9 +115,19 @@ public:
 		typed_array<vertex_descriptor, halco::hicann::v2::VLineOnHICANN> m_vertical;
 	}; // HICANN
 
-	graph_type& graph();
+	/**
+	 * @brief Returns a read-only view of the routing graph.
+	 * @note Adding HICANNs via #add() invalidates the underlying storage.  It is rebuilt
+	 *       when this function is called the next time.
+	 */
 	graph_type const& graph() const;
 
+	/**
+	 * @brief Returns the underlying storage, which still contains removed elements.
+	 * @see #graph()
+	 */
+	storage_type const& storage() const;
+
 	void add(halco::hicann::v2::HICANNOnWafer const& hicann);
 
 	void remove(PathBundle const& bundle);
@@ -76,12 +147,102 @@ public:
 	    halco::hicann::v2::HICANNOnWafer const& hicann,
 	    halco::hicann::v2::CrossbarSwitchOnHICANN const& cs);
 
+	/**
+	 * @brief Defects of several HICANNs, collected to disable them in a single pass.
+	 * Buses are translated to vertices, repeaters and crossbar switches to edges of the
+	 * routing graph.  Repeaters towards HICANNs that have not been added are ignored.
+	 * @note The mask is only valid as long as no HICANNs are added to the graph.
+	 */
+	class DefectMask
+	{
+	public:
+		/// Number of distinct graph elements disabled per class of defects.
+		struct Counts
+		{
+			Counts();
+
+			size_t hbuses;
+			size_t hrepeaters;
+			size_t vbuses;
+			size_t vrepeaters;
+			size_t crossbar_switches;
+		}; // Counts
+
+		DefectMask(L1RoutingGraph const& graph);
+
+		void disable(
+		    halco::hicann::v2::HICANNOnWafer const& hicann,
+		    halco::hicann::v2::HLineOnHICANN const& hline);
+		void disable(
+		    halco::hicann::v2::HICANNOnWafer const& hicann,
+		    halco::hicann::v2::VLineOnHICANN const& vline);
+		void disable(
+		    halco::hicann::v2::HICANNOnWafer const& hicann,
+		    halco::hicann::v2::HRepeaterOnHICANN const& hrep);
+		void disable(
+		    halco::hicann::v2::HICANNOnWafer const& hicann,
+		    halco::hicann::v2::VRepeaterOnHICANN const& vrep);
+		void disable(
+		    halco::hicann::v2::HICANNOnWafer const& hicann,
+		    halco::hicann::v2::CrossbarSwitchOnHICANN const& cs);
+
+		Counts const& counts() const;
+
+	private:
+		friend class L1RoutingGraph;
+
+		void disable_vertex(vertex_descriptor vertex, size_t& counter);
+		void disable_edge(boost::optional<edge_index_type> const& edge, size_t& counter);
+
+		L1RoutingGraph const& m_graph;
+		boost::dynamic_bitset<> m_vertices;
+		boost::dynamic_bitset<> m_edges;
+		Counts m_counts;
+	}; // DefectMask
+
+	/**
+	 * @brief Disables all elements collected in the given mask.
+	 * @throw std::invalid_argument If HICANNs have been added since creating the mask.
+	 */
+	void remove(DefectMask const& mask);
+
+	/**
+	 * @brief Checks whether the given vertex has been removed via #remove().
+	 * Removed vertices are still part of the graph, but do not have any edges.
+	 */
+	bool is_removed(vertex_descriptor vertex) const;
+
+	/**
+	 * @brief Checks whether the given edge is neither removed nor incident to a removed
+	 *        vertex.
+	 */
+	bool is_enabled(storage_type::edge_descriptor const& edge) const
+	{
+		return !m_removed_edges[m_storage[edge]] &&
+		       !m_removed_vertices[edge.src] &&
+		       !m_removed_vertices[boost::target(edge, m_storage)];
+	}
+
+	/**
+	 * @brief Returns the number of undirected edges, i.e. the exclusive upper bound of
+	 *        the indices returned by #edge_index().
+	 */
+	size_t num_edge_indices() const;
+
+	/**
+	 * @brief Returns the index of the undirected connection represented by the given edge.
+	 */
+	static edge_index_type edge_index(graph_type const& graph, edge_descriptor const& edge);
+
 	/**
 	 * @throw ResourceNotPresentError when HICANN has not been added yet.
 	 */
 	HICANN const& operator[](halco::hicann::v2::HICANNOnWafer const& hicann) const;
 
-	value_type& operator[](vertex_descriptor vertex);
+	/**
+	 * @brief Returns whether the given HICANN has been added.
+	 */
+	bool has(halco::hicann::v2::HICANNOnWafer const& hicann) const;
 
 	value_type const& operator[](vertex_descriptor vertex) const;
 
@@ -91,6 +252,8 @@ public:
 	vertex_descriptor operator[](value_type bus) const;
 
 private:
+	friend class L1RoutingGraphCache;
+
 	/**
 	 * @brief Connect given HICANN to adjacent HICANN in graph (if present).
 	 * @return Whether there was a HICANN to connect to.
@@ -101,10 +264,40 @@ private:
 		halco::hicann::v2::HICANNOnWafer (halco::hicann::v2::HICANNOnWafer::*conv)() const,
 		LineT (LineT::*line_conv)() const);
 
-	graph_type m_graph;
+	/**
+	 * @brief Returns the index of the edge connecting the given vertices (if present).
+	 */
+	boost::optional<edge_index_type> find_edge(
+	    vertex_descriptor source, vertex_descriptor target) const;
+	boost::optional<edge_index_type> find_edge(
+	    halco::hicann::v2::HICANNOnWafer const& hicann,
+	    halco::hicann::v2::HRepeaterOnHICANN const& hrep) const;
+	boost::optional<edge_index_type> find_edge(
+	    halco::hicann::v2::HICANNOnWafer const& hicann,
+	    halco::hicann::v2::VRepeaterOnHICANN const& vrep) const;
+	boost::optional<edge_index_type> find_edge(
+	    halco::hicann::v2::HICANNOnWafer const& hicann,
+	    halco::hicann::v2::CrossbarSwitchOnHICANN const& cs) const;
+
+	/**
+	 * @brief Rebuilds the compressed sparse row storage if HICANNs have been added.
+	 */
+	void update_storage() const;
+
 	std::unordered_map<halco::hicann::v2::HICANNOnWafer, HICANN> m_hicanns;
 	parameters::L1Routing m_l1_routing_parameters;
 	std::default_random_engine m_random_engine_shuffle_switches;
+
+	/// Bus of each vertex, in order of creation.
+	std::vector<value_type> m_vertices;
+	/// Undirected edges, in order of creation.  The position is used as edge index.
+	std::vector<std::pair<vertex_descriptor, vertex_descriptor> > m_edges;
+	boost::dynamic_bitset<> m_removed_vertices;
+	boost::dynamic_bitset<> m_removed_edges;
+
+	mutable storage_type m_storage;
+	mutable bool m_storage_outdated;
+	graph_type m_graph;
 }; // L1RoutingGraph
 
 } // namespace routing
@@ -117,10 +310,7 @@ struct hash<marocco::routing::L1RoutingGraph::edge_descriptor>
 {
 	size_t operator()(marocco::routing::L1RoutingGraph::edge_descriptor const& e) const
 	{
-		size_t hash = 0;
-		boost::hash_combine(hash, e.m_source);
-		boost::hash_combine(hash, e.m_target);
-		return hash;
+		return boost::hash_value(e.idx);
 	}
 };
 
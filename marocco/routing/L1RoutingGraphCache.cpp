@@ -0,0 +1,405 @@
+#include "marocco/routing/L1RoutingGraphCache.h"
+
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include <unistd.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/functional/hash.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include "halco/common/iter_all.h"
+#include "marocco/Logger.h"
+#include "marocco/util/iterable.h"
+
+using namespace halco::hicann::v2;
+using namespace halco::common;
+
+namespace marocco {
+namespace routing {
+
+namespace {
+
+typedef std::uint64_t word_type;
+
+/// Has to be incremented whenever the layout of the file or of the graph changes.
+word_type const format_version = 2;
+char const magic[8] = {'M', 'A', 'R', 'O', 'C', 'C', 'O', 'G'};
+size_t const vertices_per_hicann = HLineOnHICANN::size + VLineOnHICANN::size;
+
+static_assert(
+    sizeof(boost::dynamic_bitset<>::block_type) == sizeof(word_type),
+    "bitset blocks are stored as 64 bit words");
+
+struct Header
+{
+	char magic[8];
+	word_type version;
+	word_type key;
+	word_type num_vertices;
+	word_type num_edges;
+	word_type num_arcs;
+	/// Checksum of all words following the header.
+	word_type checksum;
+}; // Header
+
+template <typename Iterator>
+word_type checksum(word_type seed, Iterator begin, Iterator end)
+{
+	size_t hash = seed;
+	boost::hash_range(hash, begin, end);
+	return hash;
+}
+
+void write_words(std::ostream& os, std::vector<word_type> const& words)
+{
+	os.write(
+	    reinterpret_cast<char const*>(words.data()),
+	    static_cast<std::streamsize>(words.size() * sizeof(word_type)));
+}
+
+std::vector<word_type> bitset_words(boost::dynamic_bitset<> const& bits)
+{
+	std::vector<word_type> words(bits.num_blocks());
+	boost::to_block_range(bits, words.begin());
+	return words;
+}
+
+/**
+ * @brief Sequential, bounds-checked access to the words of a mapped file.
+ */
+class WordReader
+{
+public:
+	WordReader(char const* data, size_t size) : m_data(data), m_size(size), m_offset(0) {}
+
+	word_type const* begin() const
+	{
+		return reinterpret_cast<word_type const*>(m_data);
+	}
+
+	word_type const* end() const
+	{
+		return reinterpret_cast<word_type const*>(m_data + m_size);
+	}
+
+	word_type const* take(size_t count)
+	{
+		size_t const bytes = count * sizeof(word_type);
+		if (m_offset + bytes > m_size) {
+			throw std::runtime_error("truncated L1 routing graph cache entry");
+		}
+		auto const* words = reinterpret_cast<word_type const*>(m_data + m_offset);
+		m_offset += bytes;
+		return words;
+	}
+
+	bool exhausted() const
+	{
+		return m_offset == m_size;
+	}
+
+private:
+	char const* m_data;
+	size_t m_size;
+	size_t m_offset;
+}; // WordReader
+
+size_t num_blocks(size_t num_bits)
+{
+	size_t const bits_per_block = boost::dynamic_bitset<>::bits_per_block;
+	return (num_bits + bits_per_block - 1) / bits_per_block;
+}
+
+boost::dynamic_bitset<> read_bitset(WordReader& reader, size_t num_bits)
+{
+	size_t const blocks = num_blocks(num_bits);
+	word_type const* words = reader.take(blocks);
+	boost::dynamic_bitset<> bits(words, words + blocks);
+	bits.resize(num_bits);
+	return bits;
+}
+
+template <typename ComponentT>
+void hash_disabled(size_t& hash, size_t tag, ComponentT const& component)
+{
+	boost::hash_combine(hash, tag);
+	for (auto const& item : component->disabled()) {
+		boost::hash_combine(hash, item.toEnum().value());
+	}
+}
+
+} // namespace
+
+L1RoutingGraphCache::L1RoutingGraphCache(std::string const& directory) : m_directory(directory)
+{
+}
+
+auto L1RoutingGraphCache::fingerprint(
+    resource_manager_t const& resource_manager, parameters::L1Routing const& parameters)
+    -> key_type
+{
+	size_t hash = 0;
+	boost::hash_combine(hash, format_version);
+
+	auto const switch_ordering = parameters.switch_ordering();
+	boost::hash_combine(hash, static_cast<size_t>(switch_ordering));
+	if (switch_ordering ==
+	    parameters::L1Routing::SwitchOrdering::shuffle_switches_with_given_seed) {
+		boost::hash_combine(hash, parameters.shuffle_switches_seed());
+	}
+
+	// The order of HICANNs matters as it determines the numbering of vertices.
+	for (auto const& hicann : resource_manager.present()) {
+		boost::hash_combine(hash, hicann.toWafer().value());
+		boost::hash_combine(hash, hicann.toHICANNOnWafer().toEnum().value());
+
+		auto const defects = resource_manager.get(hicann);
+		hash_disabled(hash, 0, defects->hbuses());
+		hash_disabled(hash, 1, defects->hrepeaters());
+		hash_disabled(hash, 2, defects->vbuses());
+		hash_disabled(hash, 3, defects->vrepeaters());
+		hash_disabled(hash, 4, defects->crossbarswitches());
+	}
+
+	return hash;
+}
+
+bool L1RoutingGraphCache::enabled() const
+{
+	return !m_directory.empty();
+}
+
+std::string L1RoutingGraphCache::path(key_type key) const
+{
+	std::ostringstream filename;
+	filename << "l1_routing_graph-" << std::hex << std::setw(16) << std::setfill('0') << key
+	         << ".bin";
+	return (boost::filesystem::path(m_directory) / filename.str()).string();
+}
+
+bool L1RoutingGraphCache::load(
+    key_type key, std::vector<HICANNOnWafer> const& expected_hicanns, L1RoutingGraph& graph) const
+{
+	if (!graph.m_vertices.empty()) {
+		throw std::invalid_argument("can only restore cached entries into empty graphs");
+	}
+
+	if (!enabled()) {
+		return false;
+	}
+
+	std::string const filename = path(key);
+	if (!boost::filesystem::exists(filename)) {
+		MAROCCO_DEBUG("no cached L1 routing graph at " << filename);
+		return false;
+	}
+
+	try {
+		namespace bip = boost::interprocess;
+		bip::file_mapping file(filename.c_str(), bip::read_only);
+		bip::mapped_region region(file, bip::read_only);
+		auto const* data = static_cast<char const*>(region.get_address());
+		size_t const size = region.get_size();
+
+		if (size < sizeof(Header)) {
+			throw std::runtime_error("truncated header");
+		}
+		Header header;
+		std::memcpy(&header, data, sizeof(Header));
+		if (std::memcmp(header.magic, magic, sizeof(magic)) != 0 ||
+		    header.version != format_version || header.key != key ||
+		    header.num_vertices % vertices_per_hicann != 0 ||
+		    header.num_arcs != 2 * header.num_edges) {
+			throw std::runtime_error("incompatible header");
+		}
+
+		if ((size - sizeof(Header)) % sizeof(word_type) != 0) {
+			throw std::runtime_error("truncated data");
+		}
+		WordReader reader(data + sizeof(Header), size - sizeof(Header));
+		if (checksum(key, reader.begin(), reader.end()) != header.checksum) {
+			throw std::runtime_error("checksum mismatch");
+		}
+
+		size_t const num_vertices = header.num_vertices;
+		size_t const num_hicanns = num_vertices / vertices_per_hicann;
+		size_t const num_edges = header.num_edges;
+		size_t const num_arcs = header.num_arcs;
+
+		word_type const* hicanns = reader.take(num_hicanns);
+		word_type const* edges = reader.take(2 * num_edges);
+		word_type const* arcs = reader.take(2 * num_arcs);
+		word_type const* arc_properties = reader.take(num_arcs);
+		auto removed_vertices = read_bitset(reader, num_vertices);
+		auto removed_edges = read_bitset(reader, num_edges);
+		if (!reader.exhausted()) {
+			throw std::runtime_error("trailing data");
+		}
+
+		if (num_hicanns != expected_hicanns.size()) {
+			throw std::runtime_error("different number of HICANNs");
+		}
+		for (size_t ii = 0; ii < num_hicanns; ++ii) {
+			if (hicanns[ii] != expected_hicanns[ii].toEnum().value()) {
+				throw std::runtime_error("different HICANNs");
+			}
+		}
+		for (size_t ii = 0; ii < 2 * num_edges; ++ii) {
+			if (edges[ii] >= num_vertices) {
+				throw std::runtime_error("invalid vertex index of edge");
+			}
+		}
+		for (size_t ii = 0; ii < num_arcs; ++ii) {
+			if (arcs[2 * ii] >= num_vertices || arcs[2 * ii + 1] >= num_vertices) {
+				throw std::runtime_error("invalid vertex index of arc");
+			}
+			// Required for construction of the storage using boost::edges_are_sorted.
+			if (ii > 0 && arcs[2 * ii] < arcs[2 * (ii - 1)]) {
+				throw std::runtime_error("arcs not sorted by source");
+			}
+			if (arc_properties[ii] >= num_edges) {
+				throw std::runtime_error("invalid edge index of arc");
+			}
+		}
+
+		// Vertices and the lookup per HICANN follow from the order of HICANNs, see
+		// L1RoutingGraph::HICANN::HICANN().
+		graph.m_vertices.reserve(num_vertices);
+		for (size_t ii = 0; ii < num_hicanns; ++ii) {
+			HICANNOnWafer const hicann{Enum(hicanns[ii])};
+			graph.m_hicanns.insert(
+			    std::make_pair(hicann, L1RoutingGraph::HICANN(graph.m_vertices.size())));
+			for (auto hline : iter_all<HLineOnHICANN>()) {
+				graph.m_vertices.push_back(L1BusOnWafer(hicann, hline));
+			}
+			for (auto vline : iter_all<VLineOnHICANN>()) {
+				graph.m_vertices.push_back(L1BusOnWafer(hicann, vline));
+			}
+		}
+
+		graph.m_edges.resize(num_edges);
+		for (size_t ii = 0; ii < num_edges; ++ii) {
+			graph.m_edges[ii] = std::make_pair(edges[2 * ii], edges[2 * ii + 1]);
+		}
+
+		// Arcs have been written in storage order, so no sorting is necessary.
+		std::vector<std::pair<L1RoutingGraph::vertex_descriptor, L1RoutingGraph::vertex_descriptor> >
+		    sorted_arcs(num_arcs);
+		for (size_t ii = 0; ii < num_arcs; ++ii) {
+			sorted_arcs[ii] = std::make_pair(arcs[2 * ii], arcs[2 * ii + 1]);
+		}
+		graph.m_storage = L1RoutingGraph::storage_type(
+		    boost::edges_are_sorted, sorted_arcs.begin(), sorted_arcs.end(), arc_properties,
+		    num_vertices);
+		for (L1RoutingGraph::vertex_descriptor vertex = 0; vertex < num_vertices; ++vertex) {
+			graph.m_storage[vertex] = graph.m_vertices[vertex];
+		}
+		graph.m_storage_outdated = false;
+
+		graph.m_removed_vertices = std::move(removed_vertices);
+		graph.m_removed_edges = std::move(removed_edges);
+	} catch (std::exception const& err) {
+		MAROCCO_WARN("ignoring invalid L1 routing graph cache entry " << filename << ": " << err.what());
+		graph = L1RoutingGraph(graph.m_l1_routing_parameters);
+		return false;
+	}
+
+	MAROCCO_INFO("Restored L1 routing graph from " << filename);
+	return true;
+}
+
+void L1RoutingGraphCache::store(key_type key, L1RoutingGraph const& graph) const
+{
+	if (!enabled()) {
+		return;
+	}
+
+	auto const& storage = graph.graph().m_g;
+	size_t const num_vertices = graph.m_vertices.size();
+
+	Header header;
+	std::memcpy(header.magic, magic, sizeof(magic));
+	header.version = format_version;
+	header.key = key;
+	header.num_vertices = num_vertices;
+	header.num_edges = graph.m_edges.size();
+	header.num_arcs = boost::num_edges(storage);
+	header.checksum = 0;
+
+	std::vector<word_type> hicanns;
+	hicanns.reserve(num_vertices / vertices_per_hicann);
+	for (size_t vertex = 0; vertex < num_vertices; vertex += vertices_per_hicann) {
+		hicanns.push_back(graph.m_vertices[vertex].toHICANNOnWafer().toEnum().value());
+	}
+
+	std::vector<word_type> edges;
+	edges.reserve(2 * graph.m_edges.size());
+	for (auto const& edge : graph.m_edges) {
+		edges.push_back(edge.first);
+		edges.push_back(edge.second);
+	}
+
+	std::vector<word_type> arcs;
+	std::vector<word_type> arc_properties;
+	arcs.reserve(2 * header.num_arcs);
+	arc_properties.reserve(header.num_arcs);
+	for (L1RoutingGraph::vertex_descriptor vertex = 0; vertex < num_vertices; ++vertex) {
+		for (auto const& arc : make_iterable(boost::out_edges(vertex, storage))) {
+			arcs.push_back(vertex);
+			arcs.push_back(boost::target(arc, storage));
+			arc_properties.push_back(storage[arc]);
+		}
+	}
+
+	auto const removed_vertices = bitset_words(graph.m_removed_vertices);
+	auto const removed_edges = bitset_words(graph.m_removed_edges);
+
+	// Equivalent to the checksum over the concatenated words, as calculated in load().
+	word_type hash = key;
+	for (auto const& words : {std::cref(hicanns), std::cref(edges), std::cref(arcs),
+	                          std::cref(arc_properties), std::cref(removed_vertices),
+	                          std::cref(removed_edges)}) {
+		hash = checksum(hash, words.get().begin(), words.get().end());
+	}
+	header.checksum = hash;
+
+	boost::filesystem::path const filename(path(key));
+	boost::filesystem::path temporary(filename);
+	temporary += ".tmp" + std::to_string(::getpid());
+
+	try {
+		boost::filesystem::create_directories(filename.parent_path());
+		{
+			std::ofstream os(temporary.string(), std::ios::binary | std::ios::trunc);
+			os.write(reinterpret_cast<char const*>(&header), sizeof(Header));
+			write_words(os, hicanns);
+			write_words(os, edges);
+			write_words(os, arcs);
+			write_words(os, arc_properties);
+			write_words(os, removed_vertices);
+			write_words(os, removed_edges);
+			if (!os) {
+				throw std::runtime_error("could not write file");
+			}
+		}
+		boost::filesystem::rename(temporary, filename);
+	} catch (std::exception const& err) {
+		MAROCCO_WARN("could not store L1 routing graph in " << filename << ": " << err.what());
+		boost::system::error_code ignored;
+		boost::filesystem::remove(temporary, ignored);
+		return;
+	}
+
+	MAROCCO_INFO("Stored L1 routing graph in " << filename);
+}
+
+} // namespace routing
+} // namespace marocco
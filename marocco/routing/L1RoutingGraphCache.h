@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "marocco/config.h"
+#include "marocco/routing/L1RoutingGraph.h"
+#include "marocco/routing/parameters/L1Routing.h"
+
+namespace marocco {
+namespace routing {
+
+/**
+ * @brief Persistent on-disk cache of fully set up L1 routing graphs.
+ * Setting up the routing graph of a wafer and pruning it according to the defect data
+ * does not depend on the network to be mapped.  This cache stores the resulting graph
+ * in a binary format, keyed by a fingerprint of the wafer, the present HICANNs, their
+ * defects and the switch ordering.  On subsequent runs the file is memory-mapped and the
+ * graph storage is restored without rebuilding it.
+ */
+class L1RoutingGraphCache
+{
+public:
+	typedef std::uint64_t key_type;
+
+	/**
+	 * @param directory Directory used to store cached graphs.  If empty, the cache is
+	 *                  disabled.
+	 */
+	L1RoutingGraphCache(std::string const& directory);
+
+	/**
+	 * @brief Calculates the key for the graph resulting from the given defect data.
+	 * The key covers the present HICANNs of all wafers and all disabled buses, repeaters
+	 * and crossbar switches, as well as the parameters that influence the structure of
+	 * the graph.
+	 */
+	static key_type fingerprint(
+	    resource_manager_t const& resource_manager, parameters::L1Routing const& parameters);
+
+	bool enabled() const;
+
+	/**
+	 * @brief Returns the path of the file used to store the graph for the given key.
+	 */
+	std::string path(key_type key) const;
+
+	/**
+	 * @brief Restores a cached graph.
+	 * Entries are only used if their checksum matches, they contain exactly the given
+	 * HICANNs and all stored indices are consistent.
+	 * @param hicanns HICANNs of the expected graph, in the order they would be added.
+	 * @param graph Freshly constructed graph, i.e. without any HICANNs.
+	 * @return Whether a valid entry for the given key was found.
+	 * @throw std::invalid_argument If \c graph is not empty.
+	 */
+	bool load(
+	    key_type key,
+	    std::vector<halco::hicann::v2::HICANNOnWafer> const& hicanns,
+	    L1RoutingGraph& graph) const;
+
+	/**
+	 * @brief Stores the given graph.
+	 * The file is written to a temporary location first and then renamed, so concurrent
+	 * mapping runs never observe partially written entries.
+	 */
+	void store(key_type key, L1RoutingGraph const& graph) const;
+
+private:
+	std::string m_directory;
+}; // L1RoutingGraphCache
+
+} // namespace routing
+} // namespace marocco
@@ -0,0 +1,207 @@
+#include "marocco/routing/L1SteinerRouter.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "marocco/util/iterable.h"
+#include "marocco/util/radix_heap.h"
+
+namespace marocco {
+namespace routing {
+
+L1SteinerRouter::L1SteinerRouter(
+    L1EdgeWeights const& weights,
+    vertex_descriptor const& source,
+    switch_limit_type switch_limit,
+    boost::optional<RoutingWorkspace&> workspace)
+    : m_weights(weights)
+    , m_graph(weights.graph())
+    , m_source(source)
+    , m_switch_limit(std::move(switch_limit))
+    , m_switch_limits()
+    , m_targets()
+    , m_tree()
+    , m_parents()
+    , m_switches()
+    , m_own_workspace(workspace ? nullptr : new RoutingWorkspace())
+    , m_workspace(workspace ? *workspace : *m_own_workspace)
+{}
+
+void L1SteinerRouter::add_target(target_type const& target)
+{
+	m_targets.insert(std::make_pair(target, boost::none));
+}
+
+void L1SteinerRouter::run()
+{
+	typedef RoutingWorkspace::distance_type distance_type;
+
+	m_tree.assign(1, m_source);
+	m_parents.clear();
+	m_parents[m_source] = m_source;
+	m_switches.clear();
+
+	size_t unreached = m_targets.size();
+	for (auto& item : m_targets) {
+		item.second = boost::none;
+	}
+
+	radix_heap<distance_type, vertex_descriptor> queue;
+	while (unreached != 0) {
+		// Multi-source search starting from all vertices of the current tree.  As these
+		// are finished first, tree vertices fulfilling a target requirement are found
+		// before any other vertex.
+		m_workspace.reset(boost::num_vertices(m_graph));
+		queue.clear();
+		for (auto const& vertex : m_tree) {
+			m_workspace.set_distance(vertex, 0);
+			queue.push(0, vertex);
+		}
+
+		bool found = false;
+		while (!queue.empty()) {
+			vertex_descriptor const vertex = queue.top().second;
+			queue.pop();
+
+			// Vertices are queued again instead of decreasing their key, skip stale entries.
+			if (m_workspace.is_finished(vertex)) {
+				continue;
+			}
+			m_workspace.set_finished(vertex);
+
+			auto const& bus = m_graph[vertex];
+			auto it = m_targets.find(Target(bus.toHICANNOnWafer(), bus.toOrientation()));
+			if (it != m_targets.end() && it->second == boost::none) {
+				attach(vertex);
+				it->second = vertex;
+				--unreached;
+				found = true;
+				break;
+			}
+
+			distance_type const distance = m_workspace.distance(vertex);
+			size_t const used = used_switches(vertex);
+			for (auto const& edge : make_iterable(boost::out_edges(vertex, m_graph))) {
+				auto const next = boost::target(edge, m_graph);
+				if (m_workspace.is_finished(next)) {
+					continue;
+				}
+				if (is_switch(vertex, next) &&
+				    (used >= switch_limit(vertex) || switch_limit(next) == 0)) {
+					continue;
+				}
+				distance_type const candidate = distance + m_weights.weight(edge);
+				if (candidate < m_workspace.distance(next)) {
+					m_workspace.set_distance(next, candidate);
+					m_workspace.set_predecessor(next, vertex);
+					queue.push(candidate, next);
+				}
+			}
+		}
+
+		if (!found) {
+			// Remaining targets cannot be reached from the tree.
+			break;
+		}
+	}
+}
+
+void L1SteinerRouter::attach(vertex_descriptor const& vertex)
+{
+	// Collect the vertices of the new branch, starting at the vertex it is attached to.
+	PathBundle::path_type branch;
+	vertex_descriptor current = vertex;
+	while (!in_tree(current)) {
+		branch.push_back(current);
+		current = m_workspace.predecessor(current);
+	}
+	std::reverse(branch.begin(), branch.end());
+
+	for (auto const& next : branch) {
+		m_parents[next] = current;
+		if (is_switch(current, next)) {
+			++m_switches[current];
+			++m_switches[next];
+		}
+		m_tree.push_back(next);
+		current = next;
+	}
+}
+
+bool L1SteinerRouter::in_tree(vertex_descriptor const& vertex) const
+{
+	return m_parents.find(vertex) != m_parents.end();
+}
+
+bool L1SteinerRouter::is_switch(vertex_descriptor const& lhs, vertex_descriptor const& rhs) const
+{
+	return m_graph[lhs].is_vertical() != m_graph[rhs].is_vertical();
+}
+
+size_t L1SteinerRouter::used_switches(vertex_descriptor const& vertex) const
+{
+	auto it = m_switches.find(vertex);
+	if (it != m_switches.end()) {
+		return it->second;
+	}
+	if (in_tree(vertex)) {
+		return 0;
+	}
+	// Vertices outside of the tree are only used by the path leading to them.
+	return is_switch(m_workspace.predecessor(vertex), vertex) ? 1 : 0;
+}
+
+size_t L1SteinerRouter::switch_limit(vertex_descriptor const& vertex)
+{
+	if (!m_switch_limit) {
+		return 1;
+	}
+	auto it = m_switch_limits.find(vertex);
+	if (it == m_switch_limits.end()) {
+		it = m_switch_limits.insert(std::make_pair(vertex, m_switch_limit(vertex))).first;
+	}
+	return it->second;
+}
+
+PathBundle::path_type L1SteinerRouter::path_to(target_type const& target) const
+{
+	auto it = m_targets.find(target);
+	if (it == m_targets.end()) {
+		throw std::runtime_error("trying to get path to non-registered target");
+	}
+	if (it->second == boost::none) {
+		return {};
+	}
+
+	PathBundle::path_type path;
+	vertex_descriptor current = *(it->second);
+	while (true) {
+		path.push_back(current);
+		auto const parent = m_parents.at(current);
+		if (parent == current) {
+			break;
+		}
+		current = parent;
+	}
+	std::reverse(path.begin(), path.end());
+	return path;
+}
+
+PathBundle L1SteinerRouter::tree() const
+{
+	PathBundle bundle;
+	for (auto const& item : m_targets) {
+		if (item.second != boost::none) {
+			bundle.add(path_to(item.first));
+		}
+	}
+	return bundle;
+}
+
+auto L1SteinerRouter::source() const -> vertex_descriptor
+{
+	return m_source;
+}
+
+} // namespace routing
+} // namespace marocco
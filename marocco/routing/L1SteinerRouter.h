@@ -0,0 +1,127 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include <boost/optional.hpp>
+
+#include "marocco/routing/PathBundle.h"
+#include "marocco/routing/L1RoutingGraph.h"
+#include "marocco/routing/L1EdgeWeights.h"
+#include "marocco/routing/RoutingWorkspace.h"
+#include "marocco/routing/Target.h"
+
+namespace marocco {
+namespace routing {
+
+/**
+ * @brief Given a source L1 bus on some HICANN calculate a wafer-local route tree to
+ *        targets on other HICANNs using the shortest path heuristic for Steiner trees.
+ * Starting with a tree consisting only of the source, the unreached target nearest to
+ * any bus of the tree is searched for and connected to it via a shortest path
+ * (Takahashi and Matsuyama, 1980).  In contrast to a union of shortest paths from the
+ * source, later targets can branch off anywhere along the tree, which reduces the number
+ * of buses and repeaters used for sources with a large fan-out.
+ * Target L1 buses are specified via their HICANN coordinate and orientation (horizontal
+ * or vertical).
+ */
+class L1SteinerRouter
+{
+public:
+	typedef L1RoutingGraph::graph_type graph_type;
+	typedef L1RoutingGraph::vertex_descriptor vertex_descriptor;
+	typedef L1RoutingGraph::edge_descriptor edge_descriptor;
+	typedef Target target_type;
+	/**
+	 * @brief Returns the maximum number of crossbar switches that may be used on a bus.
+	 * @see resource::Manager::getMaxL1Crossbars()
+	 */
+	typedef std::function<size_t(vertex_descriptor)> switch_limit_type;
+
+	/**
+	 * @param weights Used to calculate edge weights of the shortest path searches.  A
+	 *                reference to the graph this algorithm operates on is extracted from
+	 *                this parameter.
+	 * @param source Vertex corresponding to the bus the route tree should start from.
+	 * @param switch_limit Maximum number of crossbar switches per bus.  If not given, at
+	 *                     most one switch is used per bus.
+	 * @param workspace Used to store predecessors and distances of the searches.  Can be
+	 *                  shared between consecutive routers to avoid allocations.  If not
+	 *                  given, a workspace owned by this router is used.
+	 */
+	L1SteinerRouter(
+	    L1EdgeWeights const& weights,
+	    vertex_descriptor const& source,
+	    switch_limit_type switch_limit = switch_limit_type(),
+	    boost::optional<RoutingWorkspace&> workspace = boost::none);
+
+	/**
+	 * @brief Adds target requirement.
+	 */
+	void add_target(target_type const& target);
+
+	/**
+	 * @brief Grows the route tree until all targets are reached or no further target
+	 *        can be reached.
+	 */
+	void run();
+
+	/**
+	 * @brief Returns the path along the route tree from the source to the given target.
+	 * @return Empty path if the target could not be reached.
+	 * @throw std::runtime_error when target requirement has not been registered first.
+	 */
+	PathBundle::path_type path_to(target_type const& target) const;
+
+	/**
+	 * @brief Returns the paths to all reached targets.
+	 * @see toL1RouteTree()
+	 */
+	PathBundle tree() const;
+
+	/**
+	 * @brief Returns the source vertex of the route tree.
+	 */
+	vertex_descriptor source() const;
+
+private:
+	bool in_tree(vertex_descriptor const& vertex) const;
+
+	bool is_switch(vertex_descriptor const& lhs, vertex_descriptor const& rhs) const;
+
+	/**
+	 * @brief Number of crossbar switches used on the given bus by the tree and the path
+	 *        of the current search leading to it.
+	 */
+	size_t used_switches(vertex_descriptor const& vertex) const;
+
+	/**
+	 * @brief Returns the memoized switch limit of the given bus.
+	 */
+	size_t switch_limit(vertex_descriptor const& vertex);
+
+	/**
+	 * @brief Adds the path of the current search leading to the given vertex to the tree.
+	 */
+	void attach(vertex_descriptor const& vertex);
+
+	L1EdgeWeights const& m_weights;
+	graph_type const& m_graph;
+	vertex_descriptor m_source;
+	switch_limit_type m_switch_limit;
+	std::unordered_map<vertex_descriptor, size_t> m_switch_limits;
+	/// Registered targets together with the tree vertex they have been reached with.
+	std::unordered_map<target_type, boost::optional<vertex_descriptor> > m_targets;
+	/// Vertices of the route tree in the order they have been added.
+	std::vector<vertex_descriptor> m_tree;
+	/// Predecessor of each tree vertex, the source is its own predecessor.
+	std::unordered_map<vertex_descriptor, vertex_descriptor> m_parents;
+	/// Number of crossbar switches used by the tree on each bus.
+	std::unordered_map<vertex_descriptor, size_t> m_switches;
+	std::unique_ptr<RoutingWorkspace> m_own_workspace;
+	RoutingWorkspace& m_workspace;
+}; // L1SteinerRouter
+
+} // namespace routing
+} // namespace marocco
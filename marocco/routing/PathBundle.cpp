@@ -12,6 +12,34 @@ PathBundle::vertex_descriptor target_from_path(PathBundle::path_type const& path
 	return path.back();
 }
 
+template <typename PredecessorT>
+PathBundle::path_type path_from_predecessors_impl(
+	PredecessorT const& predecessor,
+	L1RoutingGraph::vertex_descriptor const& target)
+{
+	PathBundle::path_type path;
+
+	std::set<L1RoutingGraph::vertex_descriptor> visited_vertices;
+	auto current = target;
+	while (true) {
+		path.push_back(current);
+		if (!visited_vertices.insert(current).second) {
+			std::reverse(path.begin(), path.end());
+			return path;
+		}
+
+		auto previous = predecessor(current);
+		if (previous == current) {
+			break;
+		}
+
+		current = previous;
+	}
+
+	std::reverse(path.begin(), path.end());
+	return path;
+}
+
 } // namespace
 
 PathBundle::PathBundle() : m_paths()
@@ -83,27 +111,22 @@ PathBundle::path_type path_from_predecessors(
 	std::vector<L1RoutingGraph::vertex_descriptor> const& predecessors,
 	L1RoutingGraph::vertex_descriptor const& target)
 {
-	PathBundle::path_type path;
-
-	std::set<L1RoutingGraph::vertex_descriptor> visited_vertices;
-	auto current = target;
-	while (true) {
-		path.push_back(current);
-		if (!visited_vertices.insert(current).second) {
-			std::reverse(path.begin(), path.end());
-			return path;
-		}
-
-		auto previous = predecessors[current];
-		if (previous == current) {
-			break;
-		}
-
-		current = previous;
-	}
+	return path_from_predecessors_impl(
+	    [&predecessors](L1RoutingGraph::vertex_descriptor vertex) {
+		    return predecessors[vertex];
+	    },
+	    target);
+}
 
-	std::reverse(path.begin(), path.end());
-	return path;
+PathBundle::path_type path_from_predecessors(
+	RoutingWorkspace const& workspace,
+	L1RoutingGraph::vertex_descriptor const& target)
+{
+	return path_from_predecessors_impl(
+	    [&workspace](L1RoutingGraph::vertex_descriptor vertex) {
+		    return workspace.predecessor(vertex);
+	    },
+	    target);
 }
 
 } // namespace routing
@@ -5,6 +5,7 @@
 #include <boost/iterator/transform_iterator.hpp>
 
 #include "marocco/routing/L1RoutingGraph.h"
+#include "marocco/routing/RoutingWorkspace.h"
 #include "marocco/util/iterable.h"
 
 namespace marocco {
@@ -91,5 +92,13 @@ PathBundle::path_type path_from_predecessors(
 	std::vector<L1RoutingGraph::vertex_descriptor> const& predecessors,
 	L1RoutingGraph::vertex_descriptor const& target);
 
+/**
+ * @brief Extracts a sequence of vertices from the predecessors stored in a workspace.
+ * @see path_from_predecessors()
+ */
+PathBundle::path_type path_from_predecessors(
+	RoutingWorkspace const& workspace,
+	L1RoutingGraph::vertex_descriptor const& target);
+
 } // namespace routing
 } // namespace marocco
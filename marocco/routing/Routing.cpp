@@ -1,8 +1,12 @@
+#include <algorithm>
 #include <chrono>
 #include <iterator>
+#include <limits>
+#include <set>
 
 #include "marocco/routing/Routing.h"
 
+#include <boost/functional/hash.hpp>
 #include <boost/make_shared.hpp>
 
 #include "marocco/Logger.h"
@@ -10,6 +14,8 @@
 #include "marocco/routing/HICANNRouting.h"
 #include "marocco/routing/HandleSynapseLoss.h"
 #include "marocco/routing/L1Routing.h"
+#include "marocco/routing/L1RouteCache.h"
+#include "marocco/routing/L1RoutingGraphCache.h"
 #include "marocco/routing/SynapseLoss.h"
 #include "marocco/routing/SynapseRoutingConfigurator.h"
 
@@ -20,6 +26,94 @@ using namespace halco::hicann::v2;
 namespace marocco {
 namespace routing {
 
+namespace {
+
+/// Maximum number of times the region of the routing graph is grown after routes failed.
+size_t const max_graph_region_growths = 4;
+
+void remove_defects(L1RoutingGraph& graph, resource_manager_t const& resource_manager)
+{
+	// We need to deal with defects in a separate step since each call to
+	// `graph.add` adds new edges that may need to be removed because of defects.
+	// All defects are collected first and then applied to the graph at once.
+	L1RoutingGraph::DefectMask mask(graph);
+	for (auto const& hicann : resource_manager.present()) {
+		if (!graph.has(hicann.toHICANNOnWafer())) {
+			continue;
+		}
+		auto const defects = resource_manager.get(hicann);
+
+		// horizontal buses and repeaters
+		for (auto const& hb : defects->hbuses()->disabled()) {
+			mask.disable(hicann, hb);
+		}
+		for (auto const& hr : defects->hrepeaters()->disabled()) {
+			mask.disable(hicann, hr);
+		}
+
+		// vertical buses and repeaters
+		for (auto const& vb : defects->vbuses()->disabled()) {
+			mask.disable(hicann, vb);
+		}
+		for (auto const& vr : defects->vrepeaters()->disabled()) {
+			mask.disable(hicann, vr);
+		}
+
+		// crossbar switches
+		for (auto const& cs : defects->crossbarswitches()->disabled()) {
+			mask.disable(hicann, cs);
+		}
+	}
+	graph.remove(mask);
+
+	auto const& counts = mask.counts();
+	MAROCCO_DEBUG(
+	    "Marked as defect/disabled: " << counts.hbuses << " horizontal L1 bus(es), "
+	                                  << counts.hrepeaters << " horizontal L1 repeater(s), "
+	                                  << counts.vbuses << " vertical L1 bus(es), "
+	                                  << counts.vrepeaters << " vertical L1 repeater(s), "
+	                                  << counts.crossbar_switches << " Crossbar Switch(es)");
+}
+
+/**
+ * @brief Returns all present HICANNs within the bounding box of the allocated HICANNs,
+ *        widened by the given number of HICANNs in each direction.
+ * If no HICANN has been allocated, all present HICANNs are returned.
+ */
+std::vector<HICANNOnWafer> hicanns_in_region(
+    resource_manager_t const& resource_manager, size_t margin)
+{
+	bool any_allocated = false;
+	size_t x_min = std::numeric_limits<size_t>::max();
+	size_t y_min = std::numeric_limits<size_t>::max();
+	size_t x_max = 0;
+	size_t y_max = 0;
+	for (auto const& hicann : resource_manager.allocated()) {
+		auto const hicann_on_wafer = hicann.toHICANNOnWafer();
+		size_t const x = hicann_on_wafer.x();
+		size_t const y = hicann_on_wafer.y();
+		x_min = std::min(x_min, x);
+		x_max = std::max(x_max, x);
+		y_min = std::min(y_min, y);
+		y_max = std::max(y_max, y);
+		any_allocated = true;
+	}
+
+	std::vector<HICANNOnWafer> hicanns;
+	for (auto const& hicann : resource_manager.present()) {
+		auto const hicann_on_wafer = hicann.toHICANNOnWafer();
+		size_t const x = hicann_on_wafer.x();
+		size_t const y = hicann_on_wafer.y();
+		if (!any_allocated || (x + margin >= x_min && x <= x_max + margin &&
+		                       y + margin >= y_min && y <= y_max + margin)) {
+			hicanns.push_back(hicann_on_wafer);
+		}
+	}
+	return hicanns;
+}
+
+} // namespace
+
 Routing::Routing(
 	BioGraph const& graph,
 	sthal::Wafer& hardware,
@@ -39,98 +133,101 @@ void Routing::run(results::L1Routing& l1_routing_result, results::SynapseRouting
 	m_synapse_loss = boost::make_shared<SynapseLoss>(m_graph.graph());
 
 	{
-		L1RoutingGraph l1_graph(m_pymarocco.l1_routing);
-
-		MAROCCO_INFO("Setting up L1 routing graph");
-		for (auto const& hicann : m_resource_manager.present()) {
-			l1_graph.add(hicann);
-		}
-
-		// We need to deal with defects in a separate step since each call to
-		// `l1_graph.add` adds new edges that may need to be removed because of defects.
-		for (auto const& hicann : m_resource_manager.present()) {
-			auto const defects = m_resource_manager.get(hicann);
-
-			// horizontal buses and repeaters
-			auto const hbuses = defects->hbuses();
-			for (auto const& hb : hbuses->disabled()) {
-				l1_graph.remove(hicann, hb);
-				MAROCCO_TRACE("Marked " << hb << " on " << hicann << " as defect/disabled");
-			}
-
-			size_t const n_marked_hbuses = boost::size(hbuses->disabled());
-			if (n_marked_hbuses != 0) {
-				MAROCCO_DEBUG("Marked " << n_marked_hbuses << " horizontal L1 bus(es) on "
-				                        << hicann << " as defect/disabled");
-			}
-
-			auto const hrepeaters = defects->hrepeaters();
-			for (auto const& hr : hrepeaters->disabled()) {
-				l1_graph.remove(hicann, hr);
-				MAROCCO_TRACE("Marked " << hr << " on " << hicann << " as defect/disabled");
-			}
-
-			size_t const n_marked_hrepeaters = boost::size(hrepeaters->disabled());
-			if (n_marked_hrepeaters != 0) {
-				MAROCCO_DEBUG("Marked " << n_marked_hrepeaters << " horizontal L1 repeater(s) on "
-				                        << hicann << " as defect/disabled");
+		auto const& parameters = m_pymarocco.l1_routing;
+		size_t const num_present = m_resource_manager.count_present();
+		size_t margin = parameters.graph_region_margin();
+		std::chrono::milliseconds duration_l1_routing(0);
+		std::vector<L1Routing::request_type> failed;
+		std::vector<L1Routing::request_type> rejected;
+		std::set<DNCMergerOnWafer> reroute;
+
+		// Without restriction, the loop body is only run once.  Otherwise the region of
+		// the routing graph is grown while targets could not be reached inside of it.
+		// Only sources with unreachable targets are routed again, all other sources keep
+		// their routes from the previous attempt.
+		for (size_t growths = 0;; ++growths) {
+			std::vector<HICANNOnWafer> hicanns;
+			if (parameters.restrict_graph_region()) {
+				hicanns = hicanns_in_region(m_resource_manager, margin);
+			} else {
+				for (auto const& hicann : m_resource_manager.present()) {
+					hicanns.push_back(hicann.toHICANNOnWafer());
+				}
 			}
-
-			// vertical buses and repeaters
-			auto const vbuses = defects->vbuses();
-			for (auto const& vb : vbuses->disabled()) {
-				l1_graph.remove(hicann, vb);
-				MAROCCO_TRACE("Marked " << vb << " on " << hicann << " as defect/disabled");
+			bool const complete = hicanns.size() == num_present;
+
+			L1RoutingGraph l1_graph(parameters);
+
+			L1RoutingGraphCache const graph_cache(parameters.graph_cache_directory());
+			L1RoutingGraphCache::key_type graph_key = 0;
+			bool const route_cache_enabled = !parameters.route_cache_directory().empty();
+			if (graph_cache.enabled() || route_cache_enabled) {
+				graph_key = L1RoutingGraphCache::fingerprint(m_resource_manager, parameters);
+				if (!complete) {
+					for (auto const& hicann : hicanns) {
+						boost::hash_combine(graph_key, hicann.toEnum().value());
+					}
+				}
 			}
-
-			size_t const n_marked_vbuses = boost::size(vbuses->disabled());
-			if (n_marked_vbuses != 0) {
-				MAROCCO_DEBUG("Marked " << n_marked_vbuses << " vertical L1 bus(es) on "
-				                        << hicann << " as defect/disabled");
+			bool restored = false;
+			if (graph_cache.enabled()) {
+				restored = graph_cache.load(graph_key, hicanns, l1_graph);
 			}
 
-			auto const vrepeaters = defects->vrepeaters();
-			for (auto const& vr : vrepeaters->disabled()) {
-				l1_graph.remove(hicann, vr);
-				MAROCCO_TRACE("Marked " << vr << " on " << hicann << " as defect/disabled");
+			if (!restored) {
+				MAROCCO_INFO(
+				    "Setting up L1 routing graph with " << hicanns.size() << " of "
+				                                        << num_present << " HICANNs");
+				for (auto const& hicann : hicanns) {
+					l1_graph.add(hicann);
+				}
+				remove_defects(l1_graph, m_resource_manager);
+				graph_cache.store(graph_key, l1_graph);
 			}
 
-			size_t const n_marked_vrepeaters = boost::size(vrepeaters->disabled());
-			if (n_marked_vrepeaters != 0) {
-				MAROCCO_DEBUG("Marked " << n_marked_vrepeaters << " vertical L1 repeater(s) on "
-				                        << hicann << " as defect/disabled");
+			L1RouteCache route_cache(parameters.route_cache_directory(), graph_key, parameters);
+			boost::optional<L1RouteCache&> route_cache_o;
+			if (route_cache.enabled()) {
+				route_cache.load(boost::num_vertices(l1_graph.graph()));
+				route_cache_o = route_cache;
 			}
 
-			// crossbar switches
-			auto const cswitches = defects->crossbarswitches();
-			for (auto const& cs : cswitches->disabled()) {
-				l1_graph.remove(hicann, cs);
-				MAROCCO_TRACE("Marked " << cs << " on " << hicann << " as defect/disabled");
+			auto startL1Routing = std::chrono::system_clock::now();
+			results::L1Routing result;
+			L1Routing l1_routing(
+			    l1_graph, m_graph, parameters, m_neuron_placement, result, m_resource_manager,
+			    m_pymarocco.experiment.speedup(), route_cache_o);
+			if (growths > 0) {
+				l1_routing.keep_routes(l1_routing_result, reroute);
 			}
-
-			size_t const n_marked_cswitches = boost::size(cswitches->disabled());
-			if (n_marked_cswitches != 0) {
-				MAROCCO_DEBUG(
-				    "Marked " << n_marked_cswitches << " Crossbar Switch(es) on " << hicann
-				              << " as defect/disabled");
+			l1_routing.run();
+			route_cache.store();
+			failed = l1_routing.failed_routes();
+			rejected = l1_routing.rejected_routes();
+			reroute = l1_routing.sources_with_unreachable_targets();
+			l1_routing_result = result;
+			duration_l1_routing += std::chrono::duration_cast<std::chrono::milliseconds>(
+			    std::chrono::system_clock::now() - startL1Routing);
+
+			if (reroute.empty() || complete || growths == max_graph_region_growths) {
+				break;
 			}
+			margin = std::max<size_t>(1, 2 * margin);
+			MAROCCO_INFO(
+			    "Could not reach targets of " << reroute.size()
+			                                  << " sources, growing L1 routing graph to margin of "
+			                                  << margin << " HICANNs");
 		}
-
-		auto startL1Routing = std::chrono::system_clock::now();
-		L1Routing l1_routing(
-		    l1_graph, m_graph, m_pymarocco.l1_routing, m_neuron_placement, l1_routing_result,
-		    m_resource_manager);
-		l1_routing.run();
 		MAROCCO_INFO("L1 routing finished with " << l1_routing_result.size() << " routes");
 
-		auto const& failed = l1_routing.failed_routes();
 		if (!failed.empty()) {
 			MAROCCO_WARN("Failed to establish " << failed.size() << " routes");
 		}
-		auto endL1Routing = std::chrono::system_clock::now();
-		m_pymarocco.stats.timeL1Routing =
-		    std::chrono::duration_cast<std::chrono::milliseconds>(endL1Routing - startL1Routing)
-		        .count();
+		if (!rejected.empty()) {
+			MAROCCO_WARN("Rejected " << rejected.size() << " routes exceeding the bus rate budget");
+		}
+		failed.insert(failed.end(), rejected.begin(), rejected.end());
+		m_pymarocco.stats.timeL1Routing = duration_l1_routing.count();
 
 		// Track synapse loss
 		HandleSynapseLoss handle_synapse_loss(m_graph, m_neuron_placement, l1_routing_result, m_synapse_loss);
@@ -147,7 +244,7 @@ void Routing::run(results::L1Routing& l1_routing_result, results::SynapseRouting
 	MAROCCO_INFO("Configuring L1 routes");
 	auto& wafer_config = m_hardware;
 	for (auto const& item : l1_routing_result) {
-		configure(wafer_config, item.route());
+		configure(wafer_config, item.packed_route());
 	}
 
 	auto startSynRouting = std::chrono::system_clock::now();
@@ -176,7 +273,8 @@ void Routing::run(results::L1Routing& l1_routing_result, results::SynapseRouting
 
 	// Allocate all HICANNs used in L1 routes s.t. shared parameters will be configured later.
 	for (auto const& item : l1_routing_result) {
-		for (auto const& segment : item.route().segments()) {
+		auto const route = item.route();
+		for (auto const& segment : route.segments()) {
 			if (auto const* hicann = boost::get<HICANNOnWafer>(&segment)) {
 				HICANNGlobal const resource(*hicann, m_hardware.index());
 				if (m_resource_manager.available(resource)) {
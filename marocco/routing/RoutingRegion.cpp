@@ -0,0 +1,33 @@
+#include "marocco/routing/RoutingRegion.h"
+
+using namespace halco::hicann::v2;
+
+namespace marocco {
+namespace routing {
+
+RoutingRegion::RoutingRegion(L1RoutingGraph const& graph)
+    : m_graph(&graph),
+      m_hicanns(boost::num_vertices(graph.graph()) / L1RoutingGraph::HICANN::num_vertices)
+{
+}
+
+void RoutingRegion::add(HICANNOnWafer const& hicann)
+{
+	if (!m_graph->has(hicann)) {
+		return;
+	}
+	m_hicanns.set((*m_graph)[hicann][HLineOnHICANN(0)] / L1RoutingGraph::HICANN::num_vertices);
+}
+
+bool RoutingRegion::contains(HICANNOnWafer const& hicann) const
+{
+	return m_graph->has(hicann) && contains((*m_graph)[hicann][HLineOnHICANN(0)]);
+}
+
+size_t RoutingRegion::size() const
+{
+	return m_hicanns.count();
+}
+
+} // namespace routing
+} // namespace marocco
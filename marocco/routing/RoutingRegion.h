@@ -0,0 +1,52 @@
+#pragma once
+
+#include <boost/dynamic_bitset.hpp>
+
+#include "halco/hicann/v2/hicann.h"
+#include "marocco/routing/L1RoutingGraph.h"
+
+namespace marocco {
+namespace routing {
+
+/**
+ * @brief Set of HICANNs a search on the L1 routing graph is restricted to.
+ * As the vertices of each HICANN are created consecutively (see
+ * L1RoutingGraph::HICANN::num_vertices), membership of a vertex is a single bit test.
+ */
+class RoutingRegion
+{
+public:
+	typedef L1RoutingGraph::vertex_descriptor vertex_descriptor;
+
+	/**
+	 * @brief Creates an empty region.
+	 */
+	RoutingRegion(L1RoutingGraph const& graph);
+
+	/**
+	 * @brief Adds the given HICANN to the region.
+	 * HICANNs that are not present in the routing graph are ignored.
+	 */
+	void add(halco::hicann::v2::HICANNOnWafer const& hicann);
+
+	bool contains(halco::hicann::v2::HICANNOnWafer const& hicann) const;
+
+	bool contains(vertex_descriptor vertex) const
+	{
+		size_t const index = vertex / L1RoutingGraph::HICANN::num_vertices;
+		return index < m_hicanns.size() && m_hicanns.test(index);
+	}
+
+	/**
+	 * @brief Number of HICANNs in the region.
+	 */
+	size_t size() const;
+
+private:
+	L1RoutingGraph const* m_graph;
+	/// Indexed by the position of each HICANN's vertices in the routing graph.
+	boost::dynamic_bitset<> m_hicanns;
+}; // RoutingRegion
+
+} // namespace routing
+} // namespace marocco
@@ -0,0 +1,44 @@
+#include "marocco/routing/RoutingWorkspace.h"
+
+namespace marocco {
+namespace routing {
+
+RoutingWorkspace::RoutingWorkspace() : m_epoch(0), m_size(0), m_entries(), m_switches()
+{
+}
+
+void RoutingWorkspace::reset(size_t num_vertices)
+{
+	++m_epoch;
+	if (m_epoch == 0) {
+		// Epoch counter wrapped around, entries of old epochs could become valid again.
+		for (auto& entry : m_entries) {
+			entry.epoch = 0;
+		}
+		m_epoch = 1;
+	}
+
+	if (num_vertices > m_entries.size()) {
+		m_entries.resize(num_vertices, Entry{0, false, 0, infinite_distance()});
+	}
+	m_size = num_vertices;
+	m_switches.reset(num_vertices);
+}
+
+size_t RoutingWorkspace::size() const
+{
+	return m_size;
+}
+
+SwitchOccupancy& RoutingWorkspace::switches()
+{
+	return m_switches;
+}
+
+SwitchOccupancy const& RoutingWorkspace::switches() const
+{
+	return m_switches;
+}
+
+} // namespace routing
+} // namespace marocco
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "marocco/routing/L1RoutingGraph.h"
+#include "marocco/routing/SwitchOccupancy.h"
+
+namespace marocco {
+namespace routing {
+
+/**
+ * @brief Per-vertex scratch space of graph searches on the L1 routing graph.
+ * Stores predecessor, distance and a finished flag for each vertex.  Instead of
+ * allocating and initializing arrays of size `num_vertices` for each source, a single
+ * workspace can be reused for consecutive searches: Each entry is stamped with the epoch
+ * it has been written in and entries of previous epochs read as unset, so that #reset()
+ * does not have to touch the arrays.
+ * Unset entries have the vertex itself as predecessor and an infinite distance.
+ * In addition, the crossbar switches used by paths to targets of the search are tracked.
+ * @note Results of a search stay valid only until the workspace is reset for the next one.
+ */
+class RoutingWorkspace
+{
+public:
+	typedef L1RoutingGraph::vertex_descriptor vertex_descriptor;
+	typedef size_t distance_type;
+
+	RoutingWorkspace();
+
+	/**
+	 * @brief Invalidates all entries and prepares the workspace for a graph with the given
+	 *        number of vertices.
+	 * Memory is only (re-)allocated if the graph has grown.
+	 */
+	void reset(size_t num_vertices);
+
+	/**
+	 * @brief Number of vertices this workspace has been prepared for via #reset().
+	 */
+	size_t size() const;
+
+	vertex_descriptor predecessor(vertex_descriptor vertex) const
+	{
+		auto const& entry = m_entries[vertex];
+		return entry.epoch == m_epoch ? entry.predecessor : vertex;
+	}
+
+	void set_predecessor(vertex_descriptor vertex, vertex_descriptor predecessor)
+	{
+		touch(vertex).predecessor = predecessor;
+	}
+
+	distance_type distance(vertex_descriptor vertex) const
+	{
+		auto const& entry = m_entries[vertex];
+		return entry.epoch == m_epoch ? entry.distance : infinite_distance();
+	}
+
+	void set_distance(vertex_descriptor vertex, distance_type distance)
+	{
+		touch(vertex).distance = distance;
+	}
+
+	bool is_finished(vertex_descriptor vertex) const
+	{
+		auto const& entry = m_entries[vertex];
+		return entry.epoch == m_epoch && entry.finished;
+	}
+
+	void set_finished(vertex_descriptor vertex)
+	{
+		touch(vertex).finished = true;
+	}
+
+	/**
+	 * @brief Crossbar switches used by the current search, released via #reset().
+	 */
+	SwitchOccupancy& switches();
+	SwitchOccupancy const& switches() const;
+
+	static distance_type infinite_distance()
+	{
+		return std::numeric_limits<distance_type>::max();
+	}
+
+private:
+	typedef std::uint32_t epoch_type;
+
+	struct Entry
+	{
+		epoch_type epoch;
+		bool finished;
+		vertex_descriptor predecessor;
+		distance_type distance;
+	}; // Entry
+
+	Entry& touch(vertex_descriptor vertex)
+	{
+		auto& entry = m_entries[vertex];
+		if (entry.epoch != m_epoch) {
+			entry = Entry{m_epoch, false, vertex, infinite_distance()};
+		}
+		return entry;
+	}
+
+	epoch_type m_epoch;
+	size_t m_size;
+	std::vector<Entry> m_entries;
+	SwitchOccupancy m_switches;
+}; // RoutingWorkspace
+
+} // namespace routing
+} // namespace marocco
@@ -0,0 +1,49 @@
+#include "marocco/routing/SwitchOccupancy.h"
+
+namespace marocco {
+namespace routing {
+
+SwitchOccupancy::SwitchOccupancy() : m_hicanns(), m_touched()
+{
+}
+
+void SwitchOccupancy::reset(size_t num_vertices)
+{
+	for (auto const index : m_touched) {
+		m_hicanns[index].reset();
+	}
+	m_touched.clear();
+
+	size_t const num_hicanns = (num_vertices + per_hicann - 1) / per_hicann;
+	if (num_hicanns > m_hicanns.size()) {
+		m_hicanns.resize(num_hicanns);
+	}
+}
+
+bool SwitchOccupancy::use(vertex_descriptor horizontal, vertex_descriptor vertical)
+{
+	if (is_used(horizontal) || is_used(vertical)) {
+		return false;
+	}
+	set(horizontal);
+	set(vertical);
+	return true;
+}
+
+void SwitchOccupancy::release(vertex_descriptor horizontal, vertex_descriptor vertical)
+{
+	m_hicanns[horizontal / per_hicann].reset(horizontal % per_hicann);
+	m_hicanns[vertical / per_hicann].reset(vertical % per_hicann);
+}
+
+void SwitchOccupancy::set(vertex_descriptor bus)
+{
+	auto& bits = m_hicanns[bus / per_hicann];
+	if (bits.none()) {
+		m_touched.push_back(bus / per_hicann);
+	}
+	bits.set(bus % per_hicann);
+}
+
+} // namespace routing
+} // namespace marocco
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <bitset>
+#include <vector>
+
+#include "marocco/routing/L1RoutingGraph.h"
+
+namespace marocco {
+namespace routing {
+
+/**
+ * @brief Tracks L1 buses that already use a crossbar switch.
+ * As the vertices of each HICANN are created consecutively (see
+ * L1RoutingGraph::HICANN::num_vertices), occupancy is stored in one fixed-size bitset per
+ * HICANN.  Looking up a bus only takes a division and a bit test, without hashing.
+ * Bitsets that have been written to are remembered, so that #reset() only has to clear
+ * those.
+ */
+class SwitchOccupancy
+{
+public:
+	typedef L1RoutingGraph::vertex_descriptor vertex_descriptor;
+
+	SwitchOccupancy();
+
+	/**
+	 * @brief Releases all switches and prepares the occupancy for a graph with the given
+	 *        number of vertices.
+	 */
+	void reset(size_t num_vertices);
+
+	/**
+	 * @brief Returns whether a switch is used on the given bus.
+	 */
+	bool is_used(vertex_descriptor bus) const
+	{
+		return m_hicanns[bus / per_hicann].test(bus % per_hicann);
+	}
+
+	/**
+	 * @brief Marks the crossbar switch connecting the given buses as used.
+	 * @return Whether both buses were free.  If not, nothing is changed.
+	 */
+	bool use(vertex_descriptor horizontal, vertex_descriptor vertical);
+
+	/**
+	 * @brief Releases the crossbar switch connecting the given buses.
+	 */
+	void release(vertex_descriptor horizontal, vertex_descriptor vertical);
+
+private:
+	static size_t const per_hicann = L1RoutingGraph::HICANN::num_vertices;
+
+	void set(vertex_descriptor bus);
+
+	std::vector<std::bitset<per_hicann> > m_hicanns;
+	/// Indices of bitsets that may have bits set.
+	std::vector<size_t> m_touched;
+}; // SwitchOccupancy
+
+} // namespace routing
+} // namespace marocco
@@ -11,11 +11,58 @@
 namespace marocco {
 namespace routing {
 
+namespace {
+
+results::SynapticInputs synaptic_inputs_for(
+    halco::hicann::v2::HICANNOnWafer const& hicann,
+    placement::results::Placement const& placement,
+    graph_t const& graph)
+{
+	results::SynapticInputs synaptic_inputs;
+	internal::SynapseTargetMapping::simple_mapping(hicann, placement, graph, synaptic_inputs);
+	return synaptic_inputs;
+}
+
+} // namespace
+
+struct SynapseDriverRequirementPerSource::HICANNRequirements
+{
+	HICANNRequirements(
+	    halco::hicann::v2::HICANNOnWafer const& hicann,
+	    placement::results::Placement const& placement,
+	    BioGraph const& bio_graph)
+	    : synaptic_inputs(synaptic_inputs_for(hicann, placement, bio_graph.graph())),
+	      requirements(hicann, placement, synaptic_inputs),
+	      counts(requirements.count_synapses(bio_graph))
+	{}
+
+	/// Referenced by requirements, thus has to be declared first.
+	results::SynapticInputs const synaptic_inputs;
+	SynapseDriverRequirements const requirements;
+	SynapseDriverRequirements::SynapseCountsPerSource const counts;
+};
+
 SynapseDriverRequirementPerSource::SynapseDriverRequirementPerSource(
     graph_t const& bio_graph, placement::results::Placement const& placement)
-    : m_bio_graph(bio_graph), m_placement(placement)
+    : m_bio_graph(bio_graph), m_connectivity(nullptr), m_placement(placement)
 {}
 
+SynapseDriverRequirementPerSource::SynapseDriverRequirementPerSource(
+    BioGraph const& bio_graph, placement::results::Placement const& placement)
+    : m_bio_graph(bio_graph.graph()), m_connectivity(&bio_graph), m_placement(placement)
+{}
+
+auto SynapseDriverRequirementPerSource::hicann_requirements(
+    halco::hicann::v2::HICANNOnWafer const& hicann) const -> HICANNRequirements const&
+{
+	assert(m_connectivity != nullptr);
+	auto& cached = m_cached_requirements[hicann];
+	if (!cached) {
+		cached = std::make_shared<HICANNRequirements const>(hicann, m_placement, *m_connectivity);
+	}
+	return *cached;
+}
+
 
 std::unordered_map<halco::hicann::v2::HICANNOnWafer, std::set<BioGraph::edge_descriptor> >
 SynapseDriverRequirementPerSource::targets_for_source(
@@ -119,13 +166,24 @@ void SynapseDriverRequirementPerSource::precalc(
 	// Remove HICANN if no outgoing projection has target populations there, i.e. the
 	// number of required synapse drivers is zero.
 	for (auto it = result.begin(), eit = result.end(); it != eit;) {
-		// TODO(#1594): determination whether route has synapes to target does not
-		// need to count the total number of synapses.
-		routing::results::SynapticInputs synaptic_inputs;
-		routing::internal::SynapseTargetMapping::simple_mapping(
-			it->first, m_placement, m_bio_graph, synaptic_inputs);
-		routing::SynapseDriverRequirements requirements(it->first, m_placement, synaptic_inputs);
-		auto const num = requirements.calc(merger, m_bio_graph);
+		std::pair<size_t, size_t> num(0, 0);
+		if (m_connectivity != nullptr) {
+			auto const& cached = hicann_requirements(it->first);
+			auto const counts = cached.counts.find(merger);
+			if (counts != cached.counts.end()) {
+				std::map<Side_Parity_Decoder_STP, size_t> synapse_histogram;
+				std::map<Side_Parity_Decoder_STP, size_t> synrow_histogram;
+				num = cached.requirements.calc(
+				    counts->second, synapse_histogram, synrow_histogram);
+			}
+		} else {
+			// TODO(#1594): determination whether route has synapes to target does not
+			// need to count the total number of synapses.
+			auto const synaptic_inputs = synaptic_inputs_for(it->first, m_placement, m_bio_graph);
+			routing::SynapseDriverRequirements requirements(
+			    it->first, m_placement, synaptic_inputs);
+			num = requirements.calc(merger, m_bio_graph);
+		}
 
 		if (num.first == 0u) {
 			it = result.erase(it);
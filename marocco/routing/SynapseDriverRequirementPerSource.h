@@ -1,6 +1,7 @@
 #pragma once
 
 // std header
+#include <memory>
 #include <set>
 #include <unordered_map>
 
@@ -55,6 +56,17 @@ public:
 	    graph_t const& bio_graph,
 		placement::results::Placement const& placement);
 
+	/**
+	 * Same as above, but uses the sparse connectivity of the bio graph.
+	 *
+	 * Synapses to each target HICANN are counted for all sources at once, when the
+	 * first merger with targets on that HICANN is queried, and reused for all
+	 * further mergers.
+	 */
+	SynapseDriverRequirementPerSource(
+	    BioGraph const& bio_graph,
+		placement::results::Placement const& placement);
+
 	/**
 	 * @brief Returns efferent projections of the given merger, grouped by their target.
 	 */
@@ -82,8 +94,14 @@ public:
 	    halco::hicann::v2::DNCMergerOnWafer const& merger, resource::HICANNManager const& mgr) const;
 
 private:
+	/// Driver requirements and synapse counts of all sources for a single HICANN.
+	struct HICANNRequirements;
+
 	graph_t const& m_bio_graph;
+	/// Only set if constructed from a BioGraph.
+	BioGraph const* m_connectivity;
 	placement::results::Placement const& m_placement;
+	mutable std::unordered_map<halco::hicann::v2::HICANNOnWafer, std::shared_ptr<HICANNRequirements const> > m_cached_requirements;
 	mutable std::unordered_map<halco::hicann::v2::DNCMergerOnWafer, std::unordered_map<halco::hicann::v2::HICANNOnWafer, std::set<BioGraph::edge_descriptor> > > m_cached_results;
 	mutable std::unordered_map<halco::hicann::v2::DNCMergerOnWafer, std::unordered_map<halco::hicann::v2::HICANNOnWafer, std::set<BioGraph::edge_descriptor> > > m_cached_targets;
 	mutable std::unordered_map<halco::hicann::v2::DNCMergerOnWafer, size_t> m_cached_drivers;
@@ -106,6 +124,14 @@ private:
 	 * @param [in] the merger, values shall be calculated for
 	 */
 	void precalc(halco::hicann::v2::DNCMergerOnWafer const& merger) const;
+
+	/**
+	 * @brief returns the cached requirements for the given HICANN.
+	 *
+	 * @pre Constructed from a BioGraph.
+	 */
+	HICANNRequirements const& hicann_requirements(
+	    halco::hicann::v2::HICANNOnWafer const& hicann) const;
 };
 
 } // namespace routing
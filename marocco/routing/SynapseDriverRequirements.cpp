@@ -1,5 +1,8 @@
 #include "marocco/routing/SynapseDriverRequirements.h"
+#include <algorithm>
+#include <cstdint>
 #include <tuple>
+#include <vector>
 
 #include "halco/common/iter_all.h"
 #include "marocco/routing/util.h"
@@ -526,6 +529,7 @@ std::pair<size_t, size_t> SynapseDriverRequirements::calc(
 	std::map<Side_Parity_Decoder_STP, size_t>& synrow_histogram) const
 {
 	SynapseCounts sc;
+	RelativeIndexCache<graph_t> relative_indices;
 
 	for (auto const& source_item : mPlacementResult.find(source)) {
 		for (auto const& edge : make_iterable(out_edges(source_item.population(), graph))) {
@@ -535,6 +539,10 @@ std::pair<size_t, size_t> SynapseDriverRequirements::calc(
 				continue;
 			}
 
+			auto const& indices = relative_indices.get(graph, edge);
+			size_t const src_neuron_in_proj_view =
+				to_relative_index(indices.pre, source_item.neuron_index());
+
 			Connector::const_matrix_view_type const bio_weights = proj_view.getWeights();
 			SynapseType const syntype_proj = toSynapseType(proj_view.projection()->target());
 			STPMode const stp_proj = toSTPMode(proj_view.projection()->dynamics());
@@ -551,10 +559,8 @@ std::pair<size_t, size_t> SynapseDriverRequirements::calc(
 					continue;
 				}
 
-				size_t const src_neuron_in_proj_view =
-					to_relative_index(proj_view.pre().mask(), source_item.neuron_index());
 				size_t const trg_neuron_in_proj_view =
-					to_relative_index(proj_view.post().mask(), target_item.neuron_index());
+					to_relative_index(indices.post, target_item.neuron_index());
 
 				double const weight =
 					bio_weights(src_neuron_in_proj_view, trg_neuron_in_proj_view);
@@ -576,6 +582,124 @@ std::pair<size_t, size_t> SynapseDriverRequirements::calc(
 		sc, mTargetSynapsesPerSynapticInputGranularity, synapse_histogram, synrow_histogram);
 }
 
+std::pair<size_t, size_t> SynapseDriverRequirements::calc(
+	SynapseCounts const& counts,
+	std::map<Side_Parity_Decoder_STP, size_t>& synapse_histogram,
+	std::map<Side_Parity_Decoder_STP, size_t>& synrow_histogram) const
+{
+	return _calc(
+		counts, mTargetSynapsesPerSynapticInputGranularity, synapse_histogram, synrow_histogram);
+}
+
+auto SynapseDriverRequirements::count_synapses(BioGraph const& bio_graph) const
+	-> SynapseCountsPerSource
+{
+	// The 2 MSBs of the 6 bit L1 address select the driver decoder.
+	size_t const num_driver_decoders = 4;
+
+	auto const& graph = bio_graph.graph();
+
+	// Synapse type and STP mode are shared by all synapses of a projection, only the
+	// driver decoder depends on the source neuron.  Thus the few distinct combinations
+	// of incoming projections are enumerated upfront and used as index into the counts.
+	typedef std::pair<SynapseType, STPMode> projection_property;
+	std::vector<projection_property> properties;
+
+	struct incoming_type
+	{
+		placement::results::Placement::item_type const* target_item;
+		graph_t::edge_descriptor edge;
+		size_t neuron;
+		size_t property;
+	};
+	std::vector<incoming_type> incoming;
+	std::vector<NeuronOnHICANN> neurons;
+
+	for (auto const& target_item : mPlacementResult.find(mHICANN)) {
+		auto const& logical_neuron = target_item.logical_neuron();
+		assert(!logical_neuron.is_external());
+		size_t const neuron = neurons.size();
+		neurons.push_back(logical_neuron.front());
+
+		for (auto const& edge : make_iterable(in_edges(target_item.population(), graph))) {
+			ProjectionView const& proj_view = graph[edge];
+			projection_property const property(
+				toSynapseType(proj_view.projection()->target()),
+				toSTPMode(proj_view.projection()->dynamics()));
+			auto it = std::find(properties.begin(), properties.end(), property);
+			if (it == properties.end()) {
+				it = properties.insert(it, property);
+			}
+			incoming.push_back(
+				incoming_type{&target_item, edge, neuron,
+				              static_cast<size_t>(it - properties.begin())});
+		}
+	}
+
+	size_t const property_stride = num_driver_decoders;
+	size_t const neuron_stride = properties.size() * property_stride;
+
+	// Flat histogram of synapses per source merger, indexed by target neuron, projection
+	// property and driver decoder.
+	std::unordered_map<DNCMergerOnWafer, std::vector<std::uint32_t> > histograms;
+
+	for (auto const& entry : incoming) {
+		auto const& connectivity = bio_graph.connectivity(entry.edge);
+		auto const trg_neuron_in_proj_view =
+			connectivity.post_index(entry.target_item->neuron_index());
+
+		if (trg_neuron_in_proj_view == ProjectionConnectivity::invalid) {
+			continue;
+		}
+
+		graph_t::vertex_descriptor const source = boost::source(entry.edge, graph);
+		size_t const offset = entry.neuron * neuron_stride + entry.property * property_stride;
+
+		for (auto const src_neuron_in_proj_view : connectivity.column(trg_neuron_in_proj_view)) {
+			BioNeuron const bio_neuron(source, connectivity.pre_neuron(src_neuron_in_proj_view));
+			for (auto const& source_item : mPlacementResult.find(bio_neuron)) {
+				auto const& address = source_item.address();
+				if (address == boost::none) {
+					// Source has not been assigned to a merger, so there is no route.
+					continue;
+				}
+
+				auto& histogram = histograms[address->toDNCMergerOnWafer()];
+				if (histogram.empty()) {
+					histogram.resize(neurons.size() * neuron_stride, 0);
+				}
+				size_t const decoder = address->toL1Address().getDriverDecoderMask().value();
+				assert(decoder < num_driver_decoders);
+				++histogram[offset + decoder];
+			}
+		}
+	}
+
+	SynapseCountsPerSource result;
+	for (auto const& item : histograms) {
+		SynapseCounts& counts = result[item.first];
+		auto const& histogram = item.second;
+		for (size_t neuron = 0; neuron < neurons.size(); ++neuron) {
+			for (size_t property = 0; property < properties.size(); ++property) {
+				for (size_t decoder = 0; decoder < num_driver_decoders; ++decoder) {
+					size_t const count = histogram
+						[neuron * neuron_stride + property * property_stride + decoder];
+					if (count == 0) {
+						continue;
+					}
+					counts.add(
+						neurons[neuron],
+						Type_Decoder_STP(
+							properties[property].first, DriverDecoder(decoder),
+							properties[property].second),
+						count);
+				}
+			}
+		}
+	}
+	return result;
+}
+
 std::map<Side_Parity_Decoder_STP, size_t>
 SynapseDriverRequirements::count_synapses_per_hardware_property(
     std::map<Type_Decoder_STP, size_t> const& bio_property_counts,          // neuron-wise
@@ -82,6 +82,16 @@ public:
 		mCounts[p][Type_Decoder_STP(type, addr.getDriverDecoderMask(), stp)] += 1;
 	}
 
+	/// increase synapse count for target neuron 'p' and bio synapse property 'property'
+	/// by 'count'.
+	void add(
+		halco::hicann::v2::NeuronOnHICANN const& p,
+		Type_Decoder_STP const& property,
+		size_t count)
+	{
+		mCounts[p][property] += count;
+	}
+
 	mapped_type const& get_counts() const
 	{
 		return mCounts;
@@ -188,6 +198,31 @@ public:
 		std::map<Side_Parity_Decoder_STP, size_t>& synapse_histogram,
 		std::map<Side_Parity_Decoder_STP, size_t>& synrow_histogram) const;
 
+	/// Same as above, but for synapse counts precomputed by count_synapses().
+	///
+	/// @param[in] counts synapses to neurons on this HICANN from a single source merger
+	std::pair<size_t, size_t> calc(
+		SynapseCounts const& counts,
+		std::map<Side_Parity_Decoder_STP, size_t>& synapse_histogram,
+		std::map<Side_Parity_Decoder_STP, size_t>& synrow_histogram) const;
+
+	typedef std::unordered_map<halco::hicann::v2::DNCMergerOnWafer, SynapseCounts>
+		SynapseCountsPerSource;
+
+	/// count the synapses to neurons on the current HICANN for all source mergers at
+	/// once.
+	///
+	/// In contrast to calc(), which collects the synapses of a single source merger,
+	/// the incoming connections of each target neuron are visited exactly once using
+	/// the sparse connectivity stored in the bio graph.  Counts are accumulated in
+	/// flat arrays and only converted to SynapseCounts at the end.
+	///
+	/// @param[in] bio_graph the PyNN graph of populations and projections
+	///
+	/// @return synapse counts per source merger, mergers without synapses to this
+	///         HICANN are omitted
+	SynapseCountsPerSource count_synapses(BioGraph const& bio_graph) const;
+
 	/// calculate the number of required synapse drivers for connections from the
 	/// specified sources.
 	///
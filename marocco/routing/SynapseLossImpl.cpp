@@ -1,5 +1,4 @@
 #include "marocco/routing/SynapseLossImpl.h"
-#include "marocco/routing/util.h"
 #include "marocco/Logger.h"
 #include "pymarocco/MappingStats.h"
 
@@ -11,6 +10,7 @@ namespace routing {
 using namespace euter;
 
 SynapseLossImpl::SynapseLossImpl(graph_t const& graph) :
+	mRelativeIndices(),
 	mGraph(graph)
 {}
 
@@ -59,12 +59,13 @@ void SynapseLossImpl::addLoss(Edge const& e,
 #endif // MAROCCO_NO_SYNAPSE_TRACKING
 
 	ProjectionView const view = mGraph[e];
+	auto const& indices = getRelativeIndices(e);
 
 	// calculate offsets for pre and post populations in this view
 	size_t const src_neuron_offset_in_proj_view =
-		to_relative_index(view.pre().mask(), bsrc.offset());
+		to_relative_index(indices.pre, bsrc.offset());
 	size_t const trg_neuron_offset_in_proj_view =
-		to_relative_index(view.post().mask(), btrg.offset());
+		to_relative_index(indices.post, btrg.offset());
 
 	auto const& _ws = view.getWeights();
 
@@ -335,6 +336,12 @@ SynapseLossImpl::Matrix const& SynapseLossImpl::getWeights(Edge const& e) const
 #endif // MAROCCO_NO_SYNAPSE_TRACKING
 }
 
+RelativeIndexCache<graph_t>::item_type const& SynapseLossImpl::getRelativeIndices(Edge const& e)
+{
+	tbb::mutex::scoped_lock lock(mMutex);
+	return mRelativeIndices.get(mGraph, e);
+}
+
 #ifndef MAROCCO_NO_SYNAPSE_TRACKING
 SynapseLossImpl::Matrix& SynapseLossImpl::getWeights(Edge const& e)
 {
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <boost/serialization/concurrent_unordered_map.h>
 #include <tbb/concurrent_unordered_map.h>
 #include <oneapi/tbb/mutex.h>
@@ -9,6 +10,7 @@
 #include "marocco/assignment/PopulationSlice.h"
 #include "marocco/graph.h"
 #include "marocco/routing/SynapseLossProxy.h"
+#include "marocco/routing/util.h"
 
 namespace pymarocco {
 class MappingStats;
@@ -97,11 +99,16 @@ private:
 #endif // MAROCCO_NO_SYNAPSE_TRACKING
 
 	/// tracks number synapse of lost synapses on a HICANN basis.
-	tbb::concurrent_unordered_map<Index, size_t, std::hash<Index> > mChipPre;
+	/// Source HICANNs are shared between concurrently routed target HICANNs.
+	tbb::concurrent_unordered_map<Index, std::atomic<size_t>, std::hash<Index> > mChipPre;
 	tbb::concurrent_unordered_map<Index, size_t, std::hash<Index> > mChipPost;
 
 	tbb::concurrent_unordered_map<Index, size_t, std::hash<Index> > mChipSet;
 
+	/// Relative neuron indices in projection views, guarded by mMutex.
+	RelativeIndexCache<graph_t>::item_type const& getRelativeIndices(Edge const& e);
+	RelativeIndexCache<graph_t> mRelativeIndices;
+
 	graph_t const& mGraph;
 
 	tbb::mutex mMutex;
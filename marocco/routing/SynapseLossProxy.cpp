@@ -8,11 +8,12 @@ SynapseLossProxy::value_type const SynapseLossProxy::NA =
 	std::numeric_limits<SynapseLossProxy::value_type>::quiet_NaN();
 
 #if !defined(MAROCCO_NO_SYNAPSE_TRACKING)
-SynapseLossProxy::SynapseLossProxy(Matrix& weights, size_t& pre, size_t& post, size_t& set) :
+SynapseLossProxy::SynapseLossProxy(
+	Matrix& weights, std::atomic<size_t>& pre, size_t& post, size_t& set) :
 	mWeights(weights), mChipPre(pre), mChipPost(post), mChipSet(set)
 {}
 #else
-SynapseLossProxy::SynapseLossProxy(size_t& pre, size_t& post, size_t& set) :
+SynapseLossProxy::SynapseLossProxy(std::atomic<size_t>& pre, size_t& post, size_t& set) :
 	mChipPre(pre), mChipPost(post), mChipSet(set)
 {}
 #endif // MAROCCO_NO_SYNAPSE_TRACKING
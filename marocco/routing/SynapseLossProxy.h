@@ -1,5 +1,7 @@
 #pragma once
 
+#include <atomic>
+
 #include "marocco/graph.h"
 
 namespace marocco {
@@ -14,9 +16,10 @@ public:
 	static value_type const NA;
 
 #if !defined(MAROCCO_NO_SYNAPSE_TRACKING)
-	SynapseLossProxy(Matrix& weights, size_t& pre, size_t& post, size_t& set);
+	SynapseLossProxy(
+	    Matrix& weights, std::atomic<size_t>& pre, size_t& post, size_t& set);
 #else
-	SynapseLossProxy(size_t& pre, size_t& post, size_t& set);
+	SynapseLossProxy(std::atomic<size_t>& pre, size_t& post, size_t& set);
 #endif // MAROCCO_NO_SYNAPSE_TRACKING
 
 	void addLoss(size_t i1, size_t i2);
@@ -35,7 +38,8 @@ private:
 #if !defined(MAROCCO_NO_SYNAPSE_TRACKING)
 	Matrix& mWeights;
 #endif // MAROCCO_NO_SYNAPSE_TRACKING
-	size_t& mChipPre;
+	/// Shared between synapse routing of all target HICANNs of the source HICANN.
+	std::atomic<size_t>& mChipPre;
 	size_t& mChipPost;
 	size_t& mChipSet;
 };
@@ -4,7 +4,9 @@
 #include <functional>
 #include <iterator>
 #include <stdexcept>
-#include <boost/make_shared.hpp>
+#include <utility>
+#include <vector>
+#include <boost/dynamic_bitset.hpp>
 
 #include "calibtic/HMF/SynapseDecoderDisablingSynapse.h"
 #include "halco/hicann/v2/synapse.h"
@@ -18,7 +20,6 @@
 #include "marocco/routing/SynapseLoss.h"
 #include "marocco/routing/SynapseManager.h"
 #include "marocco/routing/internal/SynapseTargetMapping.h"
-#include "marocco/routing/util.h"
 
 // NOTE: always use clear vertex and maybe edge lists, rather than vectors,
 // because we have a rather dynamically changing graph.
@@ -46,6 +47,7 @@ SynapseRouting::SynapseRouting(
 	resource_manager_t& resource_manager,
 	parameters::SynapseRouting const& parameters,
 	placement::results::Placement const& neuron_placement,
+	SynapseRoutingIndex const& index,
 	results::L1Routing const& l1_routing,
 	boost::shared_ptr<SynapseLoss> const& synapse_loss,
 	results::SynapseRouting& result)
@@ -55,6 +57,7 @@ SynapseRouting::SynapseRouting(
 	  m_resource_manager(resource_manager),
 	  m_parameters(parameters),
 	  m_neuron_placement(neuron_placement),
+	  m_index(index),
 	  m_l1_routing(l1_routing),
 	  m_synapse_loss(synapse_loss),
 	  m_result(result)
@@ -81,6 +84,10 @@ void SynapseRouting::run()
 
 	SynapseDriverRequirements drivers_required(m_hicann, m_neuron_placement, synaptic_inputs);
 
+	// Synapses to this HICANN are counted once for all incoming routes.
+	auto const synapse_counts = drivers_required.count_synapses(m_bio_graph);
+	SynapseCounts const no_synapses;
+
 	// Helper to handle synapse loss for whole routes.
 	HandleSynapseLoss handle_synapse_loss(
 		m_bio_graph, m_neuron_placement, m_l1_routing, m_synapse_loss);
@@ -113,8 +120,9 @@ void SynapseRouting::run()
 			drv_side = (drv_side == left) ? right : left;
 		}
 
+		auto const counts_it = synapse_counts.find(source_dnc);
 		auto const needed = drivers_required.calc(
-			source_dnc, m_bio_graph.graph(),
+			counts_it == synapse_counts.end() ? no_synapses : counts_it->second,
 			synapse_histogram[drv_side][vline],
 			synrow_histogram[drv_side][vline]);
 
@@ -351,53 +359,74 @@ void SynapseRouting::run()
 				SynapseLossProxy syn_loss_proxy =
 					m_synapse_loss->getProxy(edge, route_source_hicann, m_hicann);
 
-				auto const proj_view = boost::make_shared<ProjectionView>(m_bio_graph.graph()[edge]);
-				Connector::const_matrix_view_type const bio_weights = proj_view->getWeights();
-				SynapseType const syntype_proj = toSynapseType(proj_view->projection()->target());
-				STPMode const stp_proj = toSTPMode(proj_view->projection()->dynamics());
-
-				for (auto const& source_item : m_neuron_placement.find(source)) {
-					auto const& address = source_item.address();
-					// Only process source neuron placements matching current route.
-					if (address == boost::none ||
-						address->toDNCMergerOnWafer() != route_source_merger) {
+				auto const& proj_view = m_bio_graph.graph()[edge];
+				auto const& connectivity = m_bio_graph.connectivity(edge);
+				Connector::const_matrix_view_type const bio_weights = proj_view.getWeights();
+				SynapseType const syntype_proj = toSynapseType(proj_view.projection()->target());
+				STPMode const stp_proj = toSTPMode(proj_view.projection()->dynamics());
+
+				// Only neurons sending via the current route and neurons on the current
+				// HICANN can be connected by synapses here.
+				auto const& source_items = m_index.sources(route_source_merger, source);
+				auto const& target_items = m_index.targets(m_hicann, target);
+
+				// Positions of targets in projection view are shared by all sources.
+				// Targets are visited in placement order, which determines the order in
+				// which synapses are assigned.
+				std::vector<std::pair<size_t, SynapseRoutingIndex::item_type const*> > targets;
+				targets.reserve(target_items.size());
+				for (auto const* target_item : target_items) {
+					auto const trg_neuron_in_proj_view =
+						connectivity.post_index(target_item->neuron_index());
+					if (trg_neuron_in_proj_view == ProjectionConnectivity::invalid) {
 						continue;
 					}
+					targets.emplace_back(trg_neuron_in_proj_view, target_item);
+				}
+
+				if (targets.empty()) {
+					continue;
+				}
+
+				// Marks the realized connections of the current source, see below.
+				boost::dynamic_bitset<> connected(connectivity.size2());
 
-					if (!proj_view->pre().mask()[source_item.neuron_index()]) {
+				for (auto const* source_item : source_items) {
+					auto const src_neuron_in_proj_view =
+						connectivity.pre_index(source_item->neuron_index());
+					if (src_neuron_in_proj_view == ProjectionConnectivity::invalid) {
 						continue;
 					}
 
-					MAROCCO_TRACE("from " << source_item.bio_neuron() << " with " << *address);
+					auto const& address = source_item->address();
+					MAROCCO_TRACE("from " << source_item->bio_neuron() << " with " << *address);
 
-					for (auto const& target_item : m_neuron_placement.find(target)) {
-						auto const& neuron_block = target_item.neuron_block();
-						// Only process targets on current HICANN.
-						if (neuron_block == boost::none ||
-							neuron_block->toHICANNOnWafer() != m_hicann) {
-							continue;
-						}
+					// Only visit realized connections from this source: its row of the
+					// sparse connectivity is marked, so targets on this HICANN can be
+					// checked in constant time.  Marks are cleared again afterwards.
+					auto const row = connectivity.row(src_neuron_in_proj_view);
+					if (row.begin() == row.end()) {
+						continue;
+					}
+					for (auto const column : row) {
+						connected.set(column);
+					}
 
-						if (!proj_view->post().mask()[target_item.neuron_index()]) {
+					for (auto const& target : targets) {
+						if (!connected.test(target.first)) {
 							continue;
 						}
 
+						size_t const trg_neuron_in_proj_view = target.first;
+						auto const& target_item = *target.second;
+
 						MAROCCO_TRACE(
 						    "to " << target_item.bio_neuron() << " at "
 						          << target_item.logical_neuron().front());
 
-						size_t const src_neuron_in_proj_view =
-							to_relative_index(proj_view->pre().mask(), source_item.neuron_index());
-						size_t const trg_neuron_in_proj_view =
-							to_relative_index(proj_view->post().mask(), target_item.neuron_index());
-
 						double const weight =
 							bio_weights(src_neuron_in_proj_view, trg_neuron_in_proj_view);
 
-						if (std::isnan(weight) || weight <= 0.) {
-							continue;
-						}
-
 						auto const& logical_neuron = target_item.logical_neuron();
 						assert(!logical_neuron.is_external());
 						NeuronOnHICANN const target_nrn = logical_neuron.front();
@@ -459,11 +488,15 @@ void SynapseRouting::run()
 							// store synapse mapping
 							m_result.synapses().add(
 								results::Synapses::edge_type(proj_item.edge()),
-								proj_item.projection(), source_item.bio_neuron(),
+								proj_item.projection(), source_item->bio_neuron(),
 								target_item.bio_neuron(), SynapseOnWafer(syn_addr, m_hicann),
 								syntype_proj, stp_proj, weight);
 						}
 					}
+
+					for (auto const column : row) {
+						connected.reset(column);
+					}
 				}
 			}
 		} // synapse driver assignments
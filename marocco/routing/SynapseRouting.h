@@ -8,6 +8,7 @@
 #include "marocco/config.h"
 #include "marocco/placement/results/Placement.h"
 #include "marocco/routing/L1RoutingGraph.h"
+#include "marocco/routing/SynapseRoutingIndex.h"
 #include "marocco/routing/SynapseRowSource.h"
 #include "marocco/routing/parameters/SynapseRouting.h"
 #include "marocco/routing/results/L1Routing.h"
@@ -30,6 +31,7 @@ public:
 		resource_manager_t& resource_manager,
 		parameters::SynapseRouting const& parameters,
 		placement::results::Placement const& neuron_placement,
+		SynapseRoutingIndex const& index,
 		results::L1Routing const& l1_routing,
 		boost::shared_ptr<SynapseLoss> const& synapse_loss,
 		results::SynapseRouting& result);
@@ -55,6 +57,7 @@ private:
 	resource_manager_t& m_resource_manager;
 	parameters::SynapseRouting const& m_parameters;
 	placement::results::Placement const& m_neuron_placement;
+	SynapseRoutingIndex const& m_index;
 	results::L1Routing const& m_l1_routing;
 	boost::shared_ptr<SynapseLoss> m_synapse_loss;
 
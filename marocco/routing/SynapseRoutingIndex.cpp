@@ -0,0 +1,53 @@
+#include "marocco/routing/SynapseRoutingIndex.h"
+
+#include <set>
+
+using namespace halco::hicann::v2;
+
+namespace marocco {
+namespace routing {
+
+SynapseRoutingIndex::SynapseRoutingIndex(placement::results::Placement const& placement)
+	: m_targets(), m_sources(), m_empty()
+{
+	std::set<vertex_descriptor> populations;
+	for (auto const& item : placement) {
+		populations.insert(item.population());
+	}
+
+	for (auto const population : populations) {
+		for (auto const& item : placement.find(population)) {
+			if (auto const& neuron_block = item.neuron_block()) {
+				m_targets[neuron_block->toHICANNOnWafer()][population].push_back(&item);
+			}
+			if (auto const& address = item.address()) {
+				m_sources[address->toDNCMergerOnWafer()][population].push_back(&item);
+			}
+		}
+	}
+}
+
+auto SynapseRoutingIndex::targets(HICANNOnWafer const& hicann, vertex_descriptor population) const
+    -> items_type const&
+{
+	auto const it = m_targets.find(hicann);
+	if (it == m_targets.end()) {
+		return m_empty;
+	}
+	auto const pop_it = it->second.find(population);
+	return pop_it == it->second.end() ? m_empty : pop_it->second;
+}
+
+auto SynapseRoutingIndex::sources(
+    DNCMergerOnWafer const& dnc_merger, vertex_descriptor population) const -> items_type const&
+{
+	auto const it = m_sources.find(dnc_merger);
+	if (it == m_sources.end()) {
+		return m_empty;
+	}
+	auto const pop_it = it->second.find(population);
+	return pop_it == it->second.end() ? m_empty : pop_it->second;
+}
+
+} // namespace routing
+} // namespace marocco
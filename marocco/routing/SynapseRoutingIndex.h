@@ -0,0 +1,51 @@
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+#include "halco/hicann/v2/hicann.h"
+#include "halco/hicann/v2/l1.h"
+#include "marocco/placement/results/Placement.h"
+
+namespace marocco {
+namespace routing {
+
+/**
+ * @brief Lookup of placed neurons by the location relevant for synapse routing.
+ * Neurons are grouped by population and by either the HICANN they are placed on (as
+ * synapse targets) or the DNC merger their events are sent from (as synapse sources).
+ * This allows synapse routing to only visit pairs of neurons that can actually be
+ * connected by synapses on a given HICANN.
+ * Within each group, neurons are stored in the order returned by
+ * \c placement::results::Placement::find() for their population.
+ * @note The index stores pointers into the placement result, which thus must not be
+ *       modified during the lifetime of the index.
+ */
+class SynapseRoutingIndex
+{
+public:
+	typedef placement::results::Placement::item_type item_type;
+	typedef placement::results::Placement::vertex_descriptor vertex_descriptor;
+	typedef std::vector<item_type const*> items_type;
+
+	explicit SynapseRoutingIndex(placement::results::Placement const& placement);
+
+	/// Returns the neurons of the given population placed on the given HICANN.
+	items_type const& targets(
+	    halco::hicann::v2::HICANNOnWafer const& hicann, vertex_descriptor population) const;
+
+	/// Returns the neurons of the given population sending events via the given merger.
+	items_type const& sources(
+	    halco::hicann::v2::DNCMergerOnWafer const& dnc_merger,
+	    vertex_descriptor population) const;
+
+private:
+	typedef std::unordered_map<vertex_descriptor, items_type> by_population_type;
+
+	std::unordered_map<halco::hicann::v2::HICANNOnWafer, by_population_type> m_targets;
+	std::unordered_map<halco::hicann::v2::DNCMergerOnWafer, by_population_type> m_sources;
+	items_type const m_empty;
+}; // SynapseRoutingIndex
+
+} // namespace routing
+} // namespace marocco
@@ -2,6 +2,7 @@
 
 #include <stdexcept>
 #include <boost/serialization/nvp.hpp>
+#include <boost/serialization/string.hpp>
 #include <boost/serialization/unordered_map.h>
 
 namespace marocco {
@@ -12,7 +13,16 @@ L1Routing::L1Routing()
 	: m_algorithm(Algorithm::backbone),
 	  m_priority_accumulation_measure(PriorityAccumulationMeasure::arithmetic_mean),
 	  m_switch_ordering(SwitchOrdering::shuffle_switches_with_hicann_enum_as_seed),
-	  m_shuffle_switches_seed(424242)
+	  m_shuffle_switches_seed(424242),
+	  m_graph_cache_directory(),
+	  m_route_cache_directory(),
+	  m_speculative_batch_size(1),
+	  m_negotiated_congestion_iterations(30),
+	  m_bus_rate_budget(0.),
+	  m_enforce_bus_rate_budget(false),
+	  m_corridor_margin(1),
+	  m_restrict_graph_region(false),
+	  m_graph_region_margin(2)
 {
 }
 
@@ -73,8 +83,107 @@ auto L1Routing::shuffle_switches_seed() const -> size_t
 	return m_shuffle_switches_seed;
 }
 
+void L1Routing::graph_cache_directory(std::string const& value)
+{
+	m_graph_cache_directory = value;
+}
+
+std::string const& L1Routing::graph_cache_directory() const
+{
+	return m_graph_cache_directory;
+}
+
+void L1Routing::route_cache_directory(std::string const& value)
+{
+	m_route_cache_directory = value;
+}
+
+std::string const& L1Routing::route_cache_directory() const
+{
+	return m_route_cache_directory;
+}
+
+void L1Routing::speculative_batch_size(size_t value)
+{
+	if (value == 0) {
+		throw std::invalid_argument("batch size has to be larger than zero");
+	}
+	m_speculative_batch_size = value;
+}
+
+size_t L1Routing::speculative_batch_size() const
+{
+	return m_speculative_batch_size;
+}
+
+void L1Routing::negotiated_congestion_iterations(size_t value)
+{
+	if (value == 0) {
+		throw std::invalid_argument("number of iterations has to be larger than zero");
+	}
+	m_negotiated_congestion_iterations = value;
+}
+
+size_t L1Routing::negotiated_congestion_iterations() const
+{
+	return m_negotiated_congestion_iterations;
+}
+
+void L1Routing::bus_rate_budget(double value)
+{
+	if (value < 0.) {
+		throw std::invalid_argument("bus rate budget has to be non-negative");
+	}
+	m_bus_rate_budget = value;
+}
+
+double L1Routing::bus_rate_budget() const
+{
+	return m_bus_rate_budget;
+}
+
+void L1Routing::enforce_bus_rate_budget(bool value)
+{
+	m_enforce_bus_rate_budget = value;
+}
+
+bool L1Routing::enforce_bus_rate_budget() const
+{
+	return m_enforce_bus_rate_budget;
+}
+
+void L1Routing::corridor_margin(size_t value)
+{
+	m_corridor_margin = value;
+}
+
+size_t L1Routing::corridor_margin() const
+{
+	return m_corridor_margin;
+}
+
+void L1Routing::restrict_graph_region(bool value)
+{
+	m_restrict_graph_region = value;
+}
+
+bool L1Routing::restrict_graph_region() const
+{
+	return m_restrict_graph_region;
+}
+
+void L1Routing::graph_region_margin(size_t value)
+{
+	m_graph_region_margin = value;
+}
+
+size_t L1Routing::graph_region_margin() const
+{
+	return m_graph_region_margin;
+}
+
 template <typename Archive>
-void L1Routing::serialize(Archive& ar, unsigned int const /* version */)
+void L1Routing::serialize(Archive& ar, unsigned int const version)
 {
 	using namespace boost::serialization;
 	// clang-format off
@@ -83,6 +192,19 @@ void L1Routing::serialize(Archive& ar, unsigned int const /* version */)
 	   & make_nvp("priority_accumulation_measure", m_priority_accumulation_measure)
 	   & make_nvp("switch_ordering", m_switch_ordering)
 	   & make_nvp("shuffle_switches_seed", m_shuffle_switches_seed);
+
+	// Parameters added in version 1 keep their default values for older archives.
+	if (version > 0) {
+		ar & make_nvp("graph_cache_directory", m_graph_cache_directory)
+		   & make_nvp("route_cache_directory", m_route_cache_directory)
+		   & make_nvp("speculative_batch_size", m_speculative_batch_size)
+		   & make_nvp("negotiated_congestion_iterations", m_negotiated_congestion_iterations)
+		   & make_nvp("bus_rate_budget", m_bus_rate_budget)
+		   & make_nvp("enforce_bus_rate_budget", m_enforce_bus_rate_budget)
+		   & make_nvp("corridor_margin", m_corridor_margin)
+		   & make_nvp("restrict_graph_region", m_restrict_graph_region)
+		   & make_nvp("graph_region_margin", m_graph_region_margin);
+	}
 	// clang-format on
 }
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <string>
 #ifndef PYPLUSPLUS
 #include <unordered_map>
 #endif // !PYPLUSPLUS
@@ -25,10 +26,26 @@ public:
 
 	L1Routing();
 
+	/**
+	 * @brief Algorithm used to route L1 buses
+	 *
+	 * backbone: iterative horizontal growth routing, see L1BackboneRouter
+	 * dijkstra: greedy shortest paths, sources are routed in order of priority
+	 * negotiated_congestion: shortest paths with iterative rip-up and reroute, where
+	 *                        sources negotiate the use of congested L1 buses (PathFinder)
+	 * steiner: approximate Steiner trees (shortest path heuristic), sources are routed in
+	 *          order of priority; uses fewer buses for sources with many targets
+	 * hierarchical: corridors of all sources are planned on the coarse grid of HICANNs
+	 *               first, shortest paths of each source are then searched within its
+	 *               corridor, see L1CorridorPlanner
+	 */
 	PYPP_CLASS_ENUM(Algorithm)
 	{
 		backbone,
-		dijkstra
+		dijkstra,
+		negotiated_congestion,
+		steiner,
+		hierarchical
 	};
 
 	PYPP_CLASS_ENUM(PriorityAccumulationMeasure)
@@ -95,6 +112,101 @@ public:
 	void switch_ordering(SwitchOrdering value);
 	SwitchOrdering switch_ordering() const;
 
+	/**
+	 * @brief Directory used to cache fully set up L1 routing graphs.
+	 * Graphs are keyed by wafer, present HICANNs, defect data and switch ordering and
+	 * stored in a binary format that is memory-mapped on subsequent runs.
+	 * If this is empty (default), no cache is used.
+	 */
+	void graph_cache_directory(std::string const& value);
+	std::string const& graph_cache_directory() const;
+
+	/**
+	 * @brief Directory used to cache L1 routes across mapping runs.
+	 * Routes are keyed by source, target HICANNs, routing graph and algorithm parameters.
+	 * Cached routes are replayed if all buses they use are still available, only the
+	 * remaining sources are routed using the selected algorithm.
+	 * If this is empty (default), no cache is used.
+	 */
+	void route_cache_directory(std::string const& value);
+	std::string const& route_cache_directory() const;
+
+	/**
+	 * @brief Number of sources routed concurrently by the dijkstra router.
+	 * Sources of each batch are routed in parallel against the same state of the routing
+	 * graph.  The results are then committed in order of priority; sources whose routes
+	 * use buses already taken by a previously committed source of the same batch are
+	 * routed again.  The result is deterministic but may differ from sequential routing.
+	 * Default: 1, i.e. sources are routed one after another.
+	 * @throw std::invalid_argument If value is zero.
+	 */
+	void speculative_batch_size(size_t value);
+	size_t speculative_batch_size() const;
+
+	/**
+	 * @brief Maximum number of rip-up and reroute iterations of the negotiated
+	 *        congestion algorithm.
+	 * If congestion has not been resolved after this number of iterations, conflicting
+	 * sources are routed greedily in order of priority.
+	 * Default: 30.
+	 * @throw std::invalid_argument If value is zero.
+	 */
+	void negotiated_congestion_iterations(size_t value);
+	size_t negotiated_congestion_iterations() const;
+
+	/**
+	 * @brief Maximum estimated event rate of a single L1 bus in Hz (hardware time).
+	 * The event rate of each source is estimated from the firing rates of the spike
+	 * sources sent via its DNC merger, see \c placement::internal::FiringRateVisitor.
+	 * As L1 buses are used by a single source only, this is the load of all buses on the
+	 * routes of that source.  Sources exceeding this budget are reported as warnings.
+	 * Default: 0, i.e. no budget.
+	 * @throw std::invalid_argument If value is negative.
+	 */
+	void bus_rate_budget(double value);
+	double bus_rate_budget() const;
+
+	/**
+	 * @brief Whether to treat the bus rate budget as a hard constraint.
+	 * If enabled, sources exceeding #bus_rate_budget() are not routed, i.e. the affected
+	 * synapses are reported as synapse loss instead of losing events at run time.
+	 * Default: false.
+	 */
+	void enforce_bus_rate_budget(bool value);
+	bool enforce_bus_rate_budget() const;
+
+	/**
+	 * @brief Number of HICANNs by which corridors of the hierarchical router are widened
+	 *        around the HICANNs of their coarse route.
+	 * Larger values leave more room for detours in the detailed routing, at the cost of
+	 * larger searches.
+	 * Default: 1.
+	 */
+	void corridor_margin(size_t value);
+	size_t corridor_margin() const;
+
+	/**
+	 * @brief Whether to build the L1 routing graph only over the bounding box of the
+	 *        allocated HICANNs.
+	 * The bounding box is widened by #graph_region_margin() HICANNs in each direction.
+	 * If targets cannot be reached inside the region, the margin is doubled and only the
+	 * affected sources are routed again on the larger graph, while all other routes are
+	 * kept.  The region is grown at most four times and never beyond the present HICANNs.
+	 * This speeds up mappings which only use a small part of the wafer.
+	 * Default: false, i.e. all present HICANNs are used.
+	 */
+	void restrict_graph_region(bool value);
+	bool restrict_graph_region() const;
+
+	/**
+	 * @brief Initial number of HICANNs by which the region of the L1 routing graph extends
+	 *        beyond the allocated HICANNs.
+	 * @see #restrict_graph_region()
+	 * Default: 2.
+	 */
+	void graph_region_margin(size_t value);
+	size_t graph_region_margin() const;
+
 private:
 	Algorithm m_algorithm;
 #ifndef PYPLUSPLUS
@@ -103,6 +215,15 @@ private:
 	PriorityAccumulationMeasure m_priority_accumulation_measure;
 	SwitchOrdering m_switch_ordering;
 	size_t m_shuffle_switches_seed;
+	std::string m_graph_cache_directory;
+	std::string m_route_cache_directory;
+	size_t m_speculative_batch_size;
+	size_t m_negotiated_congestion_iterations;
+	double m_bus_rate_budget;
+	bool m_enforce_bus_rate_budget;
+	size_t m_corridor_margin;
+	bool m_restrict_graph_region;
+	size_t m_graph_region_margin;
 	friend class boost::serialization::access;
 	template <typename Archive>
 	void serialize(Archive& ar, unsigned int const /* version */);
@@ -113,3 +234,4 @@ private:
 } // namespace marocco
 
 BOOST_CLASS_EXPORT_KEY(::marocco::routing::parameters::L1Routing)
+BOOST_CLASS_VERSION(::marocco::routing::parameters::L1Routing, 1)
@@ -12,7 +12,7 @@ namespace routing {
 namespace parameters {
 
 SynapseRouting::SynapseRouting()
-	: m_driver_chain_length(3), m_only_allow_background_events(false)
+	: m_driver_chain_length(3), m_only_allow_background_events(false), m_parallel(false)
 {
 }
 
@@ -40,13 +40,26 @@ bool SynapseRouting::only_allow_background_events() const
 	return m_only_allow_background_events;
 }
 
+void SynapseRouting::parallel(bool enable)
+{
+	m_parallel = enable;
+}
+
+bool SynapseRouting::parallel() const
+{
+	return m_parallel;
+}
+
 template <typename Archive>
-void SynapseRouting::serialize(Archive& ar, unsigned int const /* version */)
+void SynapseRouting::serialize(Archive& ar, unsigned int const version)
 {
 	using namespace boost::serialization;
 	// clang-format off
 	ar & make_nvp("driver_chain_length", m_driver_chain_length)
 	   & make_nvp("only_allow_background_events", m_only_allow_background_events);
+	if (version > 0) {
+		ar & make_nvp("parallel", m_parallel);
+	}
 	// clang-format on
 }
 
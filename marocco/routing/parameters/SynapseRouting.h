@@ -34,9 +34,18 @@ public:
 	void only_allow_background_events(bool enable);
 	bool only_allow_background_events() const;
 
+	/**
+	 * @brief Run synapse routing for different HICANNs concurrently.
+	 * Results are collected per HICANN and merged in the order of allocated HICANNs, so
+	 * they do not depend on the scheduling of the threads.
+	 */
+	void parallel(bool enable);
+	bool parallel() const;
+
 private:
 	size_t m_driver_chain_length;
 	bool m_only_allow_background_events;
+	bool m_parallel;
 
 	friend class boost::serialization::access;
 	template <typename Archive>
@@ -48,3 +57,4 @@ private:
 } // namespace marocco
 
 BOOST_CLASS_EXPORT_KEY(::marocco::routing::parameters::SynapseRouting)
+BOOST_CLASS_VERSION(::marocco::routing::parameters::SynapseRouting, 1)
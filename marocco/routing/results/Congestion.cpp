@@ -0,0 +1,225 @@
+#include "marocco/routing/results/Congestion.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+#include <boost/optional.hpp>
+#include <boost/serialization/nvp.hpp>
+#include <boost/serialization/vector.hpp>
+
+#include "halco/common/iter_all.h"
+#include "halco/hicann/v2/l1.h"
+
+#include "marocco/placement/results/Placement.h"
+#include "marocco/results/Resources.h"
+
+using namespace halco::hicann::v2;
+using namespace halco::common;
+
+namespace marocco {
+namespace routing {
+namespace results {
+
+namespace {
+
+struct BoundingBox
+{
+	BoundingBox(HICANNOnWafer const& hicann)
+	    : x_min(hicann.x()), x_max(hicann.x()), y_min(hicann.y()), y_max(hicann.y())
+	{
+	}
+
+	void add(BoundingBox const& other)
+	{
+		x_min = std::min(x_min, other.x_min);
+		x_max = std::max(x_max, other.x_max);
+		y_min = std::min(y_min, other.y_min);
+		y_max = std::max(y_max, other.y_max);
+	}
+
+	size_t x_min;
+	size_t x_max;
+	size_t y_min;
+	size_t y_max;
+}; // BoundingBox
+
+} // namespace
+
+Congestion Congestion::estimate(
+    BioGraph::graph_type const& bio_graph,
+    placement::results::Placement const& placement,
+    marocco::results::Resources const& resources)
+{
+	Congestion result;
+	for (auto const hicann : iter_all<HICANNOnWafer>()) {
+		if (resources.has(hicann)) {
+			result.set_capacity(hicann, horizontal, HLineOnHICANN::size);
+			result.set_capacity(hicann, vertical, VLineOnHICANN::size);
+		}
+	}
+
+	// Bounding box of the target HICANNs of each population, calculated on first use.
+	std::vector<bool> visited(boost::num_vertices(bio_graph), false);
+	std::vector<boost::optional<BoundingBox> > targets(boost::num_vertices(bio_graph));
+	auto targets_of = [&](BioGraph::vertex_descriptor const population)
+	    -> boost::optional<BoundingBox> const& {
+		auto& box = targets[population];
+		if (visited[population]) {
+			return box;
+		}
+		visited[population] = true;
+		for (auto const& edge : make_iterable(boost::out_edges(population, bio_graph))) {
+			for (auto const& item : placement.find(boost::target(edge, bio_graph))) {
+				auto const& neuron_block = item.neuron_block();
+				if (neuron_block == boost::none) {
+					continue;
+				}
+				BoundingBox const hicann(neuron_block->toHICANNOnWafer());
+				if (box == boost::none) {
+					box = hicann;
+				} else {
+					box->add(hicann);
+				}
+			}
+		}
+		return box;
+	};
+
+	// Each DNC merger is a net spanning its own HICANN and all target HICANNs.
+	std::unordered_map<DNCMergerOnWafer, BoundingBox> nets;
+	for (auto const& item : placement) {
+		auto const merger = item.dnc_merger();
+		if (merger == boost::none) {
+			continue;
+		}
+		auto const& box = targets_of(item.population());
+		if (box == boost::none) {
+			continue;
+		}
+		auto it = nets.find(*merger);
+		if (it == nets.end()) {
+			it = nets.emplace(*merger, BoundingBox(merger->toHICANNOnWafer())).first;
+		}
+		it->second.add(*box);
+	}
+
+	for (auto const& net : nets) {
+		auto const& box = net.second;
+		size_t const width = box.x_max - box.x_min + 1;
+		size_t const height = box.y_max - box.y_min + 1;
+		for (size_t xx = box.x_min; xx <= box.x_max; ++xx) {
+			for (size_t yy = box.y_min; yy <= box.y_max; ++yy) {
+				try {
+					HICANNOnWafer const hicann{X(xx), Y(yy)};
+					result.add_demand(hicann, horizontal, 1. / height);
+					result.add_demand(hicann, vertical, 1. / width);
+				} catch (std::domain_error const&) {
+					// invalid combination of X and Y (can happen because wafer is round)
+				}
+			}
+		}
+	}
+
+	return result;
+}
+
+Congestion::Congestion()
+    : m_demand(HICANNOnWafer::enum_type::size * 2, 0.),
+      m_capacity(HICANNOnWafer::enum_type::size * 2, 0)
+{
+}
+
+size_t Congestion::index(hicann_type const& hicann, orientation_type const& orientation)
+{
+	return 2 * hicann.toEnum().value() + (orientation == horizontal ? 0 : 1);
+}
+
+void Congestion::add_demand(
+    hicann_type const& hicann, orientation_type const& orientation, double value)
+{
+	m_demand[index(hicann, orientation)] += value;
+}
+
+double Congestion::demand(hicann_type const& hicann, orientation_type const& orientation) const
+{
+	return m_demand[index(hicann, orientation)];
+}
+
+void Congestion::set_capacity(
+    hicann_type const& hicann, orientation_type const& orientation, size_t value)
+{
+	m_capacity[index(hicann, orientation)] = value;
+}
+
+size_t Congestion::capacity(hicann_type const& hicann, orientation_type const& orientation) const
+{
+	return m_capacity[index(hicann, orientation)];
+}
+
+double Congestion::utilization(
+    hicann_type const& hicann, orientation_type const& orientation) const
+{
+	size_t const ii = index(hicann, orientation);
+	if (m_demand[ii] == 0.) {
+		return 0.;
+	}
+	if (m_capacity[ii] == 0) {
+		return std::numeric_limits<double>::infinity();
+	}
+	return m_demand[ii] / m_capacity[ii];
+}
+
+double Congestion::max_utilization() const
+{
+	double result = 0.;
+	for (size_t ii = 0; ii < m_demand.size(); ++ii) {
+		if (m_demand[ii] == 0.) {
+			continue;
+		}
+		if (m_capacity[ii] == 0) {
+			return std::numeric_limits<double>::infinity();
+		}
+		result = std::max(result, m_demand[ii] / m_capacity[ii]);
+	}
+	return result;
+}
+
+double Congestion::total_overflow() const
+{
+	double result = 0.;
+	for (size_t ii = 0; ii < m_demand.size(); ++ii) {
+		result += std::max(0., m_demand[ii] - m_capacity[ii]);
+	}
+	return result;
+}
+
+size_t Congestion::num_overflowed() const
+{
+	size_t result = 0;
+	for (size_t ii = 0; ii < m_demand.size(); ++ii) {
+		if (m_demand[ii] > m_capacity[ii]) {
+			++result;
+		}
+	}
+	return result;
+}
+
+template <typename Archiver>
+void Congestion::serialize(Archiver& ar, const unsigned int /* version */)
+{
+	using namespace boost::serialization;
+	// clang-format off
+	ar & make_nvp("demand", m_demand)
+	   & make_nvp("capacity", m_capacity);
+	// clang-format on
+}
+
+} // namespace results
+} // namespace routing
+} // namespace marocco
+
+BOOST_CLASS_EXPORT_IMPLEMENT(::marocco::routing::results::Congestion)
+
+#include "boost/serialization/serialization_helper.tcc"
+EXPLICIT_INSTANTIATE_BOOST_SERIALIZE(::marocco::routing::results::Congestion)
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <vector>
+#include <boost/serialization/export.hpp>
+
+#include "halco/common/relations.h"
+#include "halco/hicann/v2/hicann.h"
+
+#include "marocco/BioGraph.h"
+
+namespace boost {
+namespace serialization {
+class access;
+} // namespace serialization
+} // namespace boost
+
+namespace marocco {
+
+namespace placement {
+namespace results {
+class Placement;
+} // namespace results
+} // namespace placement
+
+namespace results {
+class Resources;
+} // namespace results
+
+namespace routing {
+namespace results {
+
+/**
+ * @brief Estimated demand for and capacity of L1 buses of each HICANN.
+ * Demand and capacity are given separately for horizontal and vertical buses, i.e. for
+ * traffic in east-west and north-south direction.
+ * @see #estimate()
+ */
+class Congestion {
+public:
+	typedef halco::hicann::v2::HICANNOnWafer hicann_type;
+	typedef halco::common::Orientation orientation_type;
+
+	/**
+	 * @brief Estimates the L1 bus demand of the given placement before routing.
+	 * Uses probabilistic bounding box routing (RUDY): each DNC merger with efferent
+	 * projections is a net spanning the bounding box of its own HICANN and the HICANNs of
+	 * its target populations.  A net spanning w × h HICANNs is expected to use one
+	 * horizontal bus per column and one vertical bus per row of its bounding box.  This
+	 * demand is spread uniformly over the bounding box, i.e. each HICANN of the box is
+	 * assigned a horizontal demand of 1/h and a vertical demand of 1/w.
+	 * The capacity of each available HICANN is the number of its horizontal and vertical
+	 * buses, defects are not taken into account.
+	 * @note This does not depend on the routing and runs in time linear in the size of
+	 *       the bounding boxes, so it can be used to reject placements early.
+	 */
+	static Congestion estimate(
+	    BioGraph::graph_type const& bio_graph,
+	    placement::results::Placement const& placement,
+	    marocco::results::Resources const& resources);
+
+	Congestion();
+
+	void add_demand(
+	    hicann_type const& hicann, orientation_type const& orientation, double value);
+	double demand(hicann_type const& hicann, orientation_type const& orientation) const;
+
+	void set_capacity(
+	    hicann_type const& hicann, orientation_type const& orientation, size_t value);
+	size_t capacity(hicann_type const& hicann, orientation_type const& orientation) const;
+
+	/**
+	 * @brief Ratio of demand to capacity.
+	 * @return Zero if there is no demand, infinity if there is demand but no capacity.
+	 */
+	double utilization(hicann_type const& hicann, orientation_type const& orientation) const;
+
+	/**
+	 * @brief Largest utilization of all HICANNs and orientations.
+	 */
+	double max_utilization() const;
+
+	/**
+	 * @brief Demand exceeding capacity, summed over all HICANNs and orientations.
+	 */
+	double total_overflow() const;
+
+	/**
+	 * @brief Number of pairs of HICANN and orientation where demand exceeds capacity.
+	 */
+	size_t num_overflowed() const;
+
+private:
+	static size_t index(hicann_type const& hicann, orientation_type const& orientation);
+
+	/// Indexed by HICANN and orientation, see #index().
+	std::vector<double> m_demand;
+	std::vector<size_t> m_capacity;
+
+	friend class boost::serialization::access;
+	template <typename Archiver>
+	void serialize(Archiver& ar, const unsigned int /* version */);
+}; // Congestion
+
+} // namespace results
+} // namespace routing
+} // namespace marocco
+
+BOOST_CLASS_EXPORT_KEY(::marocco::routing::results::Congestion)
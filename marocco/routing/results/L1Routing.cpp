@@ -3,6 +3,7 @@
 #include "halco/common/relations.h"
 
 #include <boost/serialization/nvp.hpp>
+#include <boost/serialization/unordered_map.h>
 
 using namespace halco::hicann::v2;
 using namespace halco::common;
@@ -42,11 +43,16 @@ L1Routing::route_item_type::route_item_type(L1Route const& route, target_type co
 			"target HICANN has to match end of route or adjacent HICANN");
 	}
 
-	HICANNOnWafer hicann = m_route.source_hicann();
+	HICANNOnWafer hicann = route.source_hicann();
 	m_source = DNCMergerOnWafer(*merger, hicann);
 }
 
-L1Route const& L1Routing::route_item_type::route() const
+L1Route L1Routing::route_item_type::route() const
+{
+	return m_route.unpack();
+}
+
+PackedL1Route const& L1Routing::route_item_type::packed_route() const
 {
 	return m_route;
 }
@@ -155,6 +161,27 @@ auto L1Routing::find_routes_to(target_type const& target) const
 	return make_iterable(get<target_type>(m_routes).equal_range(target));
 }
 
+void L1Routing::set_predicted_rate(L1BusOnWafer const& bus, double const rate)
+{
+	m_predicted_rates[bus] = rate;
+}
+
+double L1Routing::predicted_rate(HICANNOnWafer const& hicann, HLineOnHICANN const& hline) const
+{
+	return predicted_rate(L1BusOnWafer(hicann, hline));
+}
+
+double L1Routing::predicted_rate(HICANNOnWafer const& hicann, VLineOnHICANN const& vline) const
+{
+	return predicted_rate(L1BusOnWafer(hicann, vline));
+}
+
+double L1Routing::predicted_rate(L1BusOnWafer const& bus) const
+{
+	auto const it = m_predicted_rates.find(bus);
+	return it == m_predicted_rates.end() ? 0. : it->second;
+}
+
 bool L1Routing::empty() const
 {
 	return m_routes.empty();
@@ -174,12 +201,19 @@ auto L1Routing::end() const -> iterator {
 }
 
 template <typename Archiver>
-void L1Routing::route_item_type::serialize(Archiver& ar, const unsigned int /* version */)
+void L1Routing::route_item_type::serialize(Archiver& ar, const unsigned int version)
 {
 	using namespace boost::serialization;
+	if (version > 0) {
+		ar & make_nvp("route", m_route);
+	} else {
+		// Results prior to version 1 store unpacked routes.
+		L1Route route;
+		ar & make_nvp("route", route);
+		m_route = PackedL1Route(route);
+	}
 	// clang-format off
-	ar & make_nvp("route", m_route)
-	   & make_nvp("source", m_source)
+	ar & make_nvp("source", m_source)
 	   & make_nvp("target", m_target);
 	// clang-format on
 }
@@ -197,13 +231,16 @@ void L1Routing::projection_item_type::serialize(Archiver& ar, const unsigned int
 }
 
 template <typename Archiver>
-void L1Routing::serialize(Archiver& ar, const unsigned int /* version */)
+void L1Routing::serialize(Archiver& ar, const unsigned int version)
 {
 	using namespace boost::serialization;
 	// clang-format off
 	ar & make_nvp("routes", m_routes)
 	   & make_nvp("projections", m_projections);
 	// clang-format on
+	if (version > 0) {
+		ar & make_nvp("predicted_rates", m_predicted_rates);
+	}
 }
 
 } // namespace results
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <unordered_map>
 #include <boost/multi_index/composite_key.hpp>
 #include <boost/multi_index/hashed_index.hpp>
 #include <boost/multi_index/mem_fun.hpp>
@@ -10,6 +11,8 @@
 #include "halco/hicann/v2/l1.h"
 
 #include "marocco/coordinates/L1Route.h"
+#include "marocco/coordinates/PackedL1Route.h"
+#include "marocco/routing/L1BusOnWafer.h"
 #include "marocco/routing/results/Edge.h"
 #include "marocco/util/iterable.h"
 
@@ -36,6 +39,7 @@ public:
 	 * @brief Single connection from a given DNC merger to another HICANN.
 	 * @note In addition to the L1Route this needs to explicitly store the target, as the
 	 *       end of the stored L1 route may lie on an adjacent HICANN.
+	 * The route is stored in packed form, which is also used to configure the hardware.
 	 */
 	class route_item_type {
 	public:
@@ -47,12 +51,16 @@ public:
 		 */
 		route_item_type(L1Route const& route, target_type const& target);
 
-		L1Route const& route() const;
+		/// Returns the unpacked route.
+		L1Route route() const;
+#ifndef PYPLUSPLUS
+		PackedL1Route const& packed_route() const;
+#endif // !PYPLUSPLUS
 		source_type const& source() const;
 		target_type const& target() const;
 
 	private:
-		L1Route m_route;
+		PackedL1Route m_route;
 		source_type m_source;
 		target_type m_target;
 
@@ -183,6 +191,28 @@ public:
 
 	iterable<routes_by_target_type::iterator> find_routes_to(target_type const& target) const;
 
+#ifndef PYPLUSPLUS
+	/**
+	 * @brief Record the predicted event rate of an L1 bus used by the routes, in Hz.
+	 */
+	void set_predicted_rate(L1BusOnWafer const& bus, double rate);
+#endif // !PYPLUSPLUS
+
+	/**
+	 * @brief Returns the predicted event rate of the given L1 bus, in Hz.
+	 * As L1 buses are used by a single source, this is the estimated event rate of the
+	 * source whose routes use the bus.
+	 * @return Zero if the bus is not used by any route.
+	 * @see parameters::L1Routing::bus_rate_budget()
+	 */
+	double predicted_rate(
+	    halco::hicann::v2::HICANNOnWafer const& hicann,
+	    halco::hicann::v2::HLineOnHICANN const& hline) const;
+
+	double predicted_rate(
+	    halco::hicann::v2::HICANNOnWafer const& hicann,
+	    halco::hicann::v2::VLineOnHICANN const& vline) const;
+
 	bool empty() const;
 
 	size_t size() const;
@@ -196,8 +226,13 @@ public:
 	iterator end() const;
 
 private:
+	double predicted_rate(L1BusOnWafer const& bus) const;
+
 	routes_type m_routes;
 	projections_type m_projections;
+#ifndef PYPLUSPLUS
+	std::unordered_map<L1BusOnWafer, double> m_predicted_rates;
+#endif // !PYPLUSPLUS
 
 	friend class boost::serialization::access;
 	template <typename Archiver>
@@ -216,5 +251,7 @@ PYPP_INSTANTIATE(iterable<L1Routing::routes_by_target_type::iterator>)
 } // namespace marocco
 
 BOOST_CLASS_EXPORT_KEY(::marocco::routing::results::L1Routing)
+BOOST_CLASS_VERSION(::marocco::routing::results::L1Routing, 1)
 BOOST_CLASS_EXPORT_KEY(::marocco::routing::results::L1Routing::route_item_type)
+BOOST_CLASS_VERSION(::marocco::routing::results::L1Routing::route_item_type, 1)
 BOOST_CLASS_EXPORT_KEY(::marocco::routing::results::L1Routing::projection_item_type)
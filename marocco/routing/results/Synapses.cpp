@@ -111,6 +111,18 @@ void Synapses::add(
 	}
 }
 
+void Synapses::merge(Synapses const& other)
+{
+	auto const& by_hardware_synapse = get<hardware_synapse_type>(m_container);
+	for (auto const& item : other.m_container) {
+		if (item.hardware_synapse() != boost::none &&
+		    by_hardware_synapse.find(item.hardware_synapse()) != by_hardware_synapse.end()) {
+			throw std::runtime_error("hardware synapse already in use");
+		}
+		m_container.insert(item);
+	}
+}
+
 void Synapses::add_unrealized_synapse(
 	edge_type const& edge,
 	projection_type const& projection,
@@ -157,6 +157,12 @@ public:
 		BioNeuron const& source_neuron,
 		BioNeuron const& target_neuron);
 
+	/**
+	 * @brief Adds all synapses of another result, e.g. one obtained for a different HICANN.
+	 * @throw std::runtime_error If a hardware synapse is used in both results.
+	 */
+	void merge(Synapses const& other);
+
 	/**
 	 * @brief Find all synapses belonging to the given projection.
 	 */
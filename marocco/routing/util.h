@@ -1,95 +1,108 @@
 #pragma once
 
-#include <unordered_map>
 #include <stdexcept>
+#include <unordered_map>
 
 #include "hate/macros.h"
 
-#include <boost/functional/hash.hpp>
-#include <boost/dynamic_bitset.hpp>
-#include <boost/unordered_map.hpp>
+#include "marocco/util/rank_select.h"
 
 namespace marocco {
 namespace routing {
 
 /**
  * @brief Convert index to index of subset.
- * @tparam T bitset, e.g. \c boost::dynamic_bitset<>.
- * @param mask Mask used to specify the subset.
+ * @param mask Rank/select index of the mask used to specify the subset.
  * @param index Index into original sequence.
  * @return Index into sequence of elements with positive bit in mask.
  */
-template <typename T>
-size_t to_relative_index(T const& mask, size_t const index)
+inline size_t to_relative_index(rank_select const& mask, size_t const index)
 {
 	if (HATE_UNLIKELY(index >= mask.size())) {
 		throw std::out_of_range("mask to short");
 	}
 
-	/* store global-index (0 to mask.size()) to relative-index (0 to mask.count()) */
-	static auto cache =
-	    std::make_unique<boost::unordered_map<T, std::vector<size_t> > >();
-
-	if (cache->find(mask) == cache->end()) {
-		// no entry for this mask: create and fill
-		std::vector<size_t> tmp;
-		for (size_t relative = 0, ii = 0; ii < mask.size(); ++ii) {
-			tmp.push_back(relative);
-			relative += mask[ii];
-		}
-		(*cache)[mask] = tmp;
-	}
-
 	if (HATE_UNLIKELY(!mask.test(index))) {
-		// TODO: check for *cache[mask][index-1] == [index]?
 		throw std::invalid_argument("index not enabled in mask");
 	}
 
-	return cache->at(mask).at(index);
+	return mask.rank(index);
+}
+
+/**
+ * @brief Convert index of subset to index into original sequence.
+ * Inverse of \c to_relative_index().
+ */
+inline size_t from_relative_index(rank_select const& mask, size_t const index)
+{
+	if (HATE_UNLIKELY(index >= mask.count())) {
+		throw std::out_of_range("mask to short");
+	}
+
+	return mask.select(index);
 }
 
+/**
+ * @tparam T bitset, e.g. \c boost::dynamic_bitset<>.
+ * @note This builds a \c rank_select for the mask on each call, which is linear in the
+ *       size of the mask.  Where many lookups for the same projection view are needed,
+ *       use RelativeIndexCache or the precomputed indices of \c BioGraph::connectivity()
+ *       instead.
+ */
+template <typename T>
+size_t to_relative_index(T const& mask, size_t const index)
+{
+	return to_relative_index(rank_select(mask), index);
+}
+
+/// @see to_relative_index()
 template <typename T>
 size_t from_relative_index(T const& mask, size_t const index)
 {
-	/* store relative-index (0 to mask.count()) to global-index (0 to mask.size()) */
-	static auto cache =
-	    std::make_unique<boost::unordered_map<T, std::vector<size_t> > >();
-
-	if (cache->find(mask) == cache->end()) {
-		// no entry for this mask: create and fill
-		std::vector<size_t> tmp;
-		for (size_t ii = 0; ii < mask.size(); ++ii) {
-			if (mask[ii]) {
-				tmp.push_back(ii);
-			}
+	return from_relative_index(rank_select(mask), index);
+}
+
+/**
+ * @brief Rank/select indices of the pre- and postsynaptic masks of projection views.
+ * Indices are built on first use for each edge of the graph and kept afterwards, so
+ * per-synapse lookups do not have to rebuild them.
+ * @tparam Graph Graph with projection views as edge properties, e.g. \c graph_t.
+ * @note Not thread-safe.  References to cached items stay valid when adding more edges.
+ */
+template <typename Graph>
+class RelativeIndexCache
+{
+public:
+	typedef typename Graph::edge_descriptor edge_type;
+
+	struct item_type
+	{
+		rank_select pre;
+		rank_select post;
+	}; // item_type
+
+	item_type const& get(Graph const& graph, edge_type const& edge)
+	{
+		auto it = m_items.find(edge);
+		if (it == m_items.end()) {
+			auto const& view = graph[edge];
+			it = m_items
+			         .emplace(
+			             edge,
+			             item_type{rank_select(view.pre().mask()), rank_select(view.post().mask())})
+			         .first;
 		}
-		(*cache)[mask] = tmp;
+		return it->second;
 	}
 
-	if (HATE_UNLIKELY(index >= mask.count())) {
-		// TODO: check for *cache[mask].size()?
-		throw std::out_of_range("mask to short");
+	void clear()
+	{
+		m_items.clear();
 	}
 
-	return cache->at(mask).at(index);
-}
+private:
+	std::unordered_map<edge_type, item_type> m_items;
+}; // RelativeIndexCache
 
 } // namespace routing
 } // namespace marocco
-
-#if BOOST_VERSION < 107100
-#ifdef BOOST_DYNAMIC_BITSET_DONT_USE_FRIENDS
-// provide hash_value function if we can access the private members
-namespace boost {
-	template <typename B, typename A>
-		std::size_t hash_value(const dynamic_bitset<B, A>& a) {
-			std::size_t res = hash_value(a.m_num_bits);
-			hash_combine(res, hash_value(a.m_bits));
-			return res;
-		}
-}
-#else
-#error BOOST_DYNAMIC_BITSET_DONT_USE_FRIENDS not defined. \
-       Need to access access the private member to provide hash_value function!
-#endif
-#endif // boost 1.71's dynamic_bitset introduced boost::hash_value
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace marocco {
+
+/**
+ * @brief Monotone priority queue for unsigned integer keys.
+ * Elements are distributed into buckets according to the highest bit in which their key
+ * differs from the last extracted minimum.  This requires keys to be pushed in
+ * non-decreasing order relative to the last extracted key, as it is the case for
+ * Dijkstra's algorithm with non-negative edge weights.  In exchange, push and pop run in
+ * amortized \f$\mathcal{O}(\log C)\f$, where \f$C\f$ is the largest key difference.
+ */
+template <typename KeyT, typename ValueT>
+class radix_heap
+{
+	static_assert(
+	    std::is_unsigned<KeyT>::value && std::numeric_limits<KeyT>::digits <= 64,
+	    "radix_heap requires unsigned integer keys of at most 64 bit");
+
+public:
+	typedef KeyT key_type;
+	typedef ValueT value_type;
+	typedef std::pair<key_type, value_type> element_type;
+
+	radix_heap() : m_last(0), m_size(0) {}
+
+	/**
+	 * @throw std::invalid_argument If key is smaller than the last extracted key.
+	 */
+	void push(key_type key, value_type const& value)
+	{
+		if (key < m_last) {
+			throw std::invalid_argument("radix_heap requires monotone keys");
+		}
+		m_buckets[bucket_index(key)].emplace_back(key, value);
+		++m_size;
+	}
+
+	/**
+	 * @brief Returns an element with minimal key.
+	 * @pre Heap is not empty.
+	 */
+	element_type const& top()
+	{
+		pull();
+		return m_buckets[0].back();
+	}
+
+	/**
+	 * @brief Removes the element returned by #top().
+	 * @pre Heap is not empty.
+	 */
+	void pop()
+	{
+		pull();
+		m_buckets[0].pop_back();
+		--m_size;
+	}
+
+	bool empty() const
+	{
+		return m_size == 0;
+	}
+
+	size_t size() const
+	{
+		return m_size;
+	}
+
+	/**
+	 * @brief Removes all elements and resets the last extracted key.
+	 * Already allocated memory is kept.
+	 */
+	void clear()
+	{
+		for (auto& bucket : m_buckets) {
+			bucket.clear();
+		}
+		m_last = 0;
+		m_size = 0;
+	}
+
+private:
+	static size_t const num_buckets = std::numeric_limits<KeyT>::digits + 1;
+
+	size_t bucket_index(key_type key) const
+	{
+		if (key == m_last) {
+			return 0;
+		}
+		// Position of the highest bit differing from the last extracted key, starting at 1.
+		unsigned long long const diff = key ^ m_last;
+		return std::numeric_limits<unsigned long long>::digits - __builtin_clzll(diff);
+	}
+
+	/**
+	 * @brief Makes sure the first bucket contains the elements with minimal key.
+	 */
+	void pull()
+	{
+		assert(!empty());
+		if (!m_buckets[0].empty()) {
+			return;
+		}
+
+		size_t index = 1;
+		while (m_buckets[index].empty()) {
+			++index;
+		}
+
+		auto& bucket = m_buckets[index];
+		key_type minimum = bucket.front().first;
+		for (auto const& element : bucket) {
+			if (element.first < minimum) {
+				minimum = element.first;
+			}
+		}
+
+		// All elements of this bucket go to lower buckets relative to the new minimum.
+		m_last = minimum;
+		for (auto& element : bucket) {
+			m_buckets[bucket_index(element.first)].push_back(std::move(element));
+		}
+		bucket.clear();
+	}
+
+	key_type m_last;
+	size_t m_size;
+	std::array<std::vector<element_type>, num_buckets> m_buckets;
+}; // radix_heap
+
+} // namespace marocco
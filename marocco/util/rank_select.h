@@ -0,0 +1,118 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+#include <boost/iterator/function_output_iterator.hpp>
+
+namespace marocco {
+
+/**
+ * @brief Immutable bitset supporting rank and select queries.
+ * Bits are stored in 64 bit words together with the number of set bits preceding each
+ * word.  Thus \c rank() runs in constant time using a single popcount, while \c select()
+ * performs a binary search over the per-word counts.  Memory overhead is one 32 bit
+ * counter per 64 bits of the mask.
+ * This is used to translate between absolute neuron indices in a population and relative
+ * indices in a population view without hashing the mask on every lookup.
+ */
+class rank_select
+{
+	typedef std::uint64_t word_type;
+	static constexpr size_t bits_per_word = std::numeric_limits<word_type>::digits;
+
+public:
+	rank_select() : m_size(0), m_words(), m_ranks(1, 0) {}
+
+	template <typename Block, typename Allocator>
+	explicit rank_select(boost::dynamic_bitset<Block, Allocator> const& mask)
+		: m_size(mask.size()),
+		  m_words((mask.size() + bits_per_word - 1) / bits_per_word, 0),
+		  m_ranks()
+	{
+		typedef boost::dynamic_bitset<Block, Allocator> mask_type;
+		static_assert(
+		    bits_per_word % mask_type::bits_per_block == 0,
+		    "blocks of mask have to evenly divide words of rank_select");
+
+		// Unused bits of the last block are guaranteed to be zero.
+		size_t block = 0;
+		boost::to_block_range(mask, boost::make_function_output_iterator([&](Block bits) {
+			size_t const offset = block * mask_type::bits_per_block;
+			m_words[offset / bits_per_word] |= word_type(bits) << (offset % bits_per_word);
+			++block;
+		}));
+
+		m_ranks.reserve(m_words.size() + 1);
+		m_ranks.push_back(0);
+		for (word_type const word : m_words) {
+			m_ranks.push_back(m_ranks.back() + __builtin_popcountll(word));
+		}
+	}
+
+	/// Number of bits.
+	size_t size() const
+	{
+		return m_size;
+	}
+
+	/// Number of set bits.
+	size_t count() const
+	{
+		return m_ranks.back();
+	}
+
+	bool test(size_t index) const
+	{
+		if (index >= m_size) {
+			throw std::out_of_range("index out of range of mask");
+		}
+		return (m_words[index / bits_per_word] >> (index % bits_per_word)) & 1;
+	}
+
+	/**
+	 * @brief Number of set bits before the given position.
+	 * For a set bit this is its index in the sequence of set bits.
+	 */
+	size_t rank(size_t index) const
+	{
+		if (index >= m_size) {
+			throw std::out_of_range("index out of range of mask");
+		}
+		size_t const word = index / bits_per_word;
+		word_type const below = (word_type(1) << (index % bits_per_word)) - 1;
+		return m_ranks[word] + __builtin_popcountll(m_words[word] & below);
+	}
+
+	/**
+	 * @brief Position of the n-th set bit, i.e. inverse of \c rank() for set bits.
+	 * @throw std::out_of_range If less than <tt>n + 1</tt> bits are set.
+	 */
+	size_t select(size_t n) const
+	{
+		if (n >= count()) {
+			throw std::out_of_range("not enough bits set in mask");
+		}
+		// Last word with less than n + 1 set bits before it contains the n-th set bit.
+		auto const it = std::upper_bound(m_ranks.begin(), m_ranks.end(), n) - 1;
+		size_t const word = static_cast<size_t>(it - m_ranks.begin());
+		word_type bits = m_words[word];
+		for (size_t remaining = n - *it; remaining > 0; --remaining) {
+			// Clear lowest set bit.
+			bits &= bits - 1;
+		}
+		return word * bits_per_word + __builtin_ctzll(bits);
+	}
+
+private:
+	size_t m_size;
+	std::vector<word_type> m_words;
+	/// Number of set bits in all preceding words, with the total count appended.
+	std::vector<std::uint32_t> m_ranks;
+}; // rank_select
+
+} // namespace marocco
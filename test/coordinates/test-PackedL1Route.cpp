@@ -0,0 +1,97 @@
+#include <sstream>
+#include <gtest/gtest.h>
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+
+#include "halco/hicann/v2/fwd.h"
+#include "marocco/coordinates/PackedL1Route.h"
+
+namespace marocco {
+
+using namespace halco::hicann::v2;
+using namespace halco::common;
+
+class APackedL1Route : public ::testing::Test
+{
+protected:
+	L1Route route{HICANNOnWafer(X(5), Y(5)),
+	              Merger0OnHICANN(2),
+	              DNCMergerOnHICANN(2),
+	              HLineOnHICANN(46),
+	              HICANNOnWafer(X(6), Y(5)),
+	              HLineOnHICANN(48),
+	              VLineOnHICANN(39),
+	              SynapseDriverOnHICANN(left, Y(99)),
+	              SynapseOnHICANN(SynapseColumnOnHICANN(5), SynapseRowOnHICANN(0))};
+};
+
+TEST(PackedL1Route, empty)
+{
+	PackedL1Route packed;
+	EXPECT_TRUE(packed.empty());
+	EXPECT_TRUE(packed.begin() == packed.end());
+	EXPECT_TRUE(packed.unpack().empty());
+	EXPECT_TRUE(PackedL1Route(L1Route()).empty());
+}
+
+TEST_F(APackedL1Route, canBeUnpacked)
+{
+	PackedL1Route const packed(route);
+	ASSERT_EQ(route.size(), packed.size());
+	EXPECT_EQ(route, packed.unpack());
+	EXPECT_EQ(route.source_hicann(), packed.source_hicann());
+	EXPECT_EQ(route.target_hicann(), packed.unpack().target_hicann());
+	for (size_t ii = 0; ii < route.size(); ++ii) {
+		EXPECT_EQ(route[ii], packed[ii]);
+	}
+}
+
+TEST_F(APackedL1Route, usesOneWordPerSegment)
+{
+	PackedL1Route const packed(route);
+	EXPECT_EQ(route.size(), packed.words().size());
+	for (auto const word : packed.words()) {
+		EXPECT_EQ(word, PackedL1Route::encode(PackedL1Route::decode(word)));
+	}
+}
+
+TEST_F(APackedL1Route, hasTypedIterator)
+{
+	PackedL1Route const packed(route);
+	auto it = packed.begin();
+	EXPECT_EQ(PackedL1Route::Tag::hicann, it.tag());
+	EXPECT_EQ(HICANNOnWafer(X(5), Y(5)), it.as<HICANNOnWafer>());
+	EXPECT_EQ(PackedL1Route::Tag::merger0, (++it).tag());
+	EXPECT_EQ(PackedL1Route::Tag::dnc_merger, (++it).tag());
+	EXPECT_EQ(PackedL1Route::Tag::hline, (++it).tag());
+	EXPECT_EQ(HLineOnHICANN(46), it.as<HLineOnHICANN>());
+	EXPECT_EQ(HLineOnHICANN(46).toEnum().value(), it.value());
+
+	it = packed.begin() + 6;
+	EXPECT_EQ(PackedL1Route::Tag::vline, it.tag());
+	EXPECT_EQ(VLineOnHICANN(39), it.as<VLineOnHICANN>());
+	EXPECT_EQ(PackedL1Route::Tag::synapse, (packed.end() - 1).tag());
+	EXPECT_EQ(std::ptrdiff_t(route.size()), std::distance(packed.begin(), packed.end()));
+
+	std::vector<L1Route::segment_type> const segments(packed.begin(), packed.end());
+	EXPECT_EQ(route.segments(), segments);
+}
+
+TEST_F(APackedL1Route, canBeSerialized)
+{
+	PackedL1Route const packed(route);
+	std::stringstream stream;
+	{
+		boost::archive::binary_oarchive oa(stream);
+		oa << packed;
+	}
+
+	PackedL1Route loaded;
+	{
+		boost::archive::binary_iarchive ia(stream);
+		ia >> loaded;
+	}
+	EXPECT_EQ(packed, loaded);
+}
+
+} // namespace marocco
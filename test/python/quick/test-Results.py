@@ -1,7 +1,7 @@
 import os
 import unittest
 
-from pyhalco_common import Enum
+from pyhalco_common import Enum, horizontal, vertical
 import pyhalco_hicann_v2 as C
 import pyhmf as pynn
 
@@ -24,6 +24,38 @@ class TestResults(utils.TestWithResults):
         results = self.load_results()
         self.assertEqual(1, len(list(results.placement)))
 
+    def test_estimate_congestion(self):
+        """
+        The L1 bus demand of a placement can be estimated from the
+        results without L1 routing.
+        """
+        pynn.setup(marocco=self.marocco)
+
+        source = pynn.Population(1, pynn.IF_cond_exp, {})
+        target = pynn.Population(1, pynn.IF_cond_exp, {})
+        source_hicann = C.HICANNOnWafer(Enum(167))
+        target_hicann = C.HICANNOnWafer(Enum(170))
+        self.marocco.manual_placement.on_hicann(source, source_hicann)
+        self.marocco.manual_placement.on_hicann(target, target_hicann)
+        pynn.Projection(
+            source, target, pynn.AllToAllConnector(weights=0.004))
+
+        pynn.run(0)
+        pynn.end()
+
+        results = self.load_results()
+        congestion = results.estimate_congestion()
+
+        # The net spans four HICANNs in a single row.
+        for hicann in [source_hicann, target_hicann]:
+            self.assertEqual(
+                C.HLineOnHICANN.size, congestion.capacity(hicann, horizontal))
+            self.assertEqual(1., congestion.demand(hicann, horizontal))
+            self.assertEqual(0.25, congestion.demand(hicann, vertical))
+        self.assertEqual(
+            0., congestion.demand(C.HICANNOnWafer(Enum(100)), horizontal))
+        self.assertEqual(0, congestion.num_overflowed())
+
     @utils.parametrize([2, 4, 6, 8])
     def test_small_network(self, neuron_size):
         self.marocco.neuron_placement.default_neuron_size(neuron_size)
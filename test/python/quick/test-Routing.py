@@ -9,7 +9,46 @@ import pyredman
 import utils
 
 
+def used_buses(results):
+    """
+    Returns the L1 buses used by the routes of each source, as a mapping
+    from source to a set of (x, y, bus) tuples, where x and y are the
+    coordinates of the HICANN the bus belongs to.
+    """
+    buses = {}
+    for item in results.l1_routing:
+        hicann = None
+        used = buses.setdefault(str(item.source()), set())
+        for segment in item.route():
+            if isinstance(segment, C.HICANNOnWafer):
+                hicann = segment
+            elif isinstance(segment, (C.HLineOnHICANN, C.VLineOnHICANN)):
+                used.add((hicann.x().value(), hicann.y().value(), str(segment)))
+    return buses
+
+
 class TestRouting(utils.TestWithResults):
+    def map_network(self, build, name):
+        """
+        Maps the network set up by `build` and returns the results.
+        Each mapping is persisted to a separate file, so that the results
+        of several runs can be compared within the same test.
+        """
+        self.marocco.persist = os.path.join(
+            self.temporary_directory, "{}.bin".format(name))
+        pynn.setup(marocco=self.marocco)
+        build()
+        pynn.run(0)
+        pynn.end()
+        return self.load_results()
+
+    def assertNoSharedBuses(self, results):
+        buses = used_buses(results)
+        for source, used in buses.items():
+            for other, other_used in buses.items():
+                if source != other:
+                    self.assertFalse(used & other_used)
+
     def test_dijkstra_routing(self):
         """
         Integration test for Dijkstra-based L1 routing.
@@ -53,6 +92,311 @@ class TestRouting(utils.TestWithResults):
         synapses = results.synapse_routing.synapses()
         self.assertEqual(1, synapses.size())
 
+    def test_speculative_dijkstra_routing(self):
+        """
+        Routing sources in speculative batches is deterministic and the
+        committed routes of different sources do not share any bus.
+        """
+        source_hicanns = [167, 168, 169, 170, 206, 240, 241, 242]
+        target_hicanns = [171, 205, 207, 239, 243]
+
+        def build():
+            targets = []
+            for hicann in target_hicanns:
+                target = pynn.Population(1, pynn.IF_cond_exp, {})
+                self.marocco.manual_placement.on_hicann(
+                    target, C.HICANNOnWafer(Enum(hicann)))
+                targets.append(target)
+
+            for hicann in source_hicanns:
+                source = pynn.Population(1, pynn.IF_cond_exp, {})
+                self.marocco.manual_placement.on_hicann(
+                    source, C.HICANNOnWafer(Enum(hicann)))
+                for target in targets:
+                    pynn.Projection(
+                        source, target, pynn.AllToAllConnector(weights=0.004))
+
+        def routes(results):
+            return set(
+                (str(item.source()), str(item.target()),
+                 tuple(str(segment) for segment in item.route()))
+                for item in results.l1_routing)
+
+        self.marocco.l1_routing.algorithm(self.marocco.l1_routing.dijkstra)
+
+        for batch_size in [1, 8]:
+            self.marocco.l1_routing.speculative_batch_size(batch_size)
+            first = self.map_network(build, "batch_{}_a".format(batch_size))
+            second = self.map_network(build, "batch_{}_b".format(batch_size))
+
+            self.assertEqual(
+                len(source_hicanns) * len(target_hicanns),
+                first.synapse_routing.synapses().size())
+            self.assertEqual(routes(first), routes(second))
+
+            self.assertEqual(len(source_hicanns), len(used_buses(first)))
+            self.assertNoSharedBuses(first)
+
+    def test_negotiated_congestion_routing(self):
+        """
+        Integration test for L1 routing with negotiated congestion.
+
+        Routes several sources on a restricted set of HICANNs, so that
+        sources have to share the few available paths.  The resulting
+        routes must not use any bus twice.
+        """
+        pynn.setup(marocco=self.marocco)
+
+        target = pynn.Population(1, pynn.IF_cond_exp, {})
+        target_hicann = C.HICANNOnWafer(Enum(242))
+        self.marocco.manual_placement.on_hicann(target, target_hicann)
+
+        sources = []
+        for hicann in [167, 168, 240]:
+            source = pynn.Population(1, pynn.IF_cond_exp, {})
+            self.marocco.manual_placement.on_hicann(
+                source, C.HICANNOnWafer(Enum(hicann)))
+            pynn.Projection(
+                source, target, pynn.AllToAllConnector(weights=0.004))
+            sources.append(source)
+
+        allowed_hicanns = [206] + list(range(167, 171)) + list(range(240, 243))
+        wafer = self.marocco.default_wafer
+        self.marocco.defects.set(pyredman.Wafer())
+        for hicann in C.iter_all(C.HICANNOnWafer):
+            if hicann.toEnum().value() in allowed_hicanns:
+                continue
+            self.marocco.defects.wafer().hicanns().disable(C.HICANNGlobal(hicann, wafer))
+
+        self.marocco.l1_routing.algorithm(
+            self.marocco.l1_routing.negotiated_congestion)
+        self.marocco.l1_routing.negotiated_congestion_iterations(10)
+
+        pynn.run(0)
+        pynn.end()
+
+        results = self.load_results()
+
+        synapses = results.synapse_routing.synapses()
+        self.assertEqual(len(sources), synapses.size())
+
+        self.assertEqual(len(sources), len(used_buses(results)))
+        self.assertNoSharedBuses(results)
+
+    def build_fanout_network(self):
+        source = pynn.Population(1, pynn.IF_cond_exp, {})
+        self.marocco.manual_placement.on_hicann(
+            source, C.HICANNOnWafer(Enum(167)))
+
+        for hicann in [170, 206, 240, 242]:
+            target = pynn.Population(1, pynn.IF_cond_exp, {})
+            self.marocco.manual_placement.on_hicann(
+                target, C.HICANNOnWafer(Enum(hicann)))
+            pynn.Projection(
+                source, target, pynn.AllToAllConnector(weights=0.004))
+
+    def test_steiner_routing(self):
+        """
+        Steiner tree L1 routing of a source with several target HICANNs
+        does not use more buses than the shortest path tree found by the
+        dijkstra router.
+        """
+        self.marocco.l1_routing.algorithm(self.marocco.l1_routing.dijkstra)
+        dijkstra = self.map_network(self.build_fanout_network, "dijkstra")
+
+        self.marocco.l1_routing.algorithm(self.marocco.l1_routing.steiner)
+        steiner = self.map_network(self.build_fanout_network, "steiner")
+
+        self.assertEqual(4, dijkstra.synapse_routing.synapses().size())
+        self.assertEqual(4, steiner.synapse_routing.synapses().size())
+
+        dijkstra_buses, = used_buses(dijkstra).values()
+        steiner_buses, = used_buses(steiner).values()
+        self.assertLessEqual(len(steiner_buses), len(dijkstra_buses))
+
+    def test_hierarchical_routing(self):
+        """
+        L1 routing within corridors planned on the coarse grid of HICANNs
+        only uses buses of HICANNs within the corridor, which for targets
+        in the same row as the source and a margin of zero is that row.
+        """
+        pynn.setup(marocco=self.marocco)
+
+        source_hicann = C.HICANNOnWafer(Enum(167))
+        source = pynn.Population(1, pynn.IF_cond_exp, {})
+        self.marocco.manual_placement.on_hicann(source, source_hicann)
+
+        targets = []
+        for hicann in [169, 170]:
+            target = pynn.Population(1, pynn.IF_cond_exp, {})
+            self.marocco.manual_placement.on_hicann(
+                target, C.HICANNOnWafer(Enum(hicann)))
+            pynn.Projection(
+                source, target, pynn.AllToAllConnector(weights=0.004))
+            targets.append(target)
+
+        self.marocco.l1_routing.algorithm(self.marocco.l1_routing.hierarchical)
+        self.marocco.l1_routing.corridor_margin(0)
+
+        pynn.run(0)
+        pynn.end()
+
+        results = self.load_results()
+
+        synapses = results.synapse_routing.synapses()
+        self.assertEqual(len(targets), synapses.size())
+
+        buses, = used_buses(results).values()
+        last_hicann = C.HICANNOnWafer(Enum(170))
+        for x, y, _ in buses:
+            self.assertEqual(source_hicann.y().value(), y)
+            self.assertLessEqual(source_hicann.x().value(), x)
+            self.assertGreaterEqual(last_hicann.x().value(), x)
+
+    def test_restricted_graph_region(self):
+        """
+        Routing on a graph restricted to the region around the allocated
+        HICANNs, which has to be grown as the HICANNs in between the
+        populations are not available and a margin of zero does not leave
+        room for a detour.
+        """
+        pynn.setup(marocco=self.marocco)
+
+        source_hicann = C.HICANNOnWafer(Enum(167))
+        source = pynn.Population(1, pynn.IF_cond_exp, {})
+        target = pynn.Population(1, pynn.IF_cond_exp, {})
+        pynn.Projection(
+            source, target, pynn.AllToAllConnector(weights=0.004))
+
+        self.marocco.manual_placement.on_hicann(source, source_hicann)
+        self.marocco.manual_placement.on_hicann(
+            target, C.HICANNOnWafer(Enum(170)))
+
+        wafer = self.marocco.default_wafer
+        self.marocco.defects.set(pyredman.Wafer())
+        for hicann in [168, 169]:
+            self.marocco.defects.wafer().hicanns().disable(
+                C.HICANNGlobal(C.HICANNOnWafer(Enum(hicann)), wafer))
+
+        self.marocco.l1_routing.algorithm(self.marocco.l1_routing.dijkstra)
+        self.marocco.l1_routing.restrict_graph_region(True)
+        self.marocco.l1_routing.graph_region_margin(0)
+
+        pynn.run(0)
+        pynn.end()
+
+        results = self.load_results()
+
+        synapses = results.synapse_routing.synapses()
+        self.assertEqual(1, synapses.size())
+
+        # The detour leaves the row of the allocated HICANNs, i.e. the
+        # initial region of the routing graph.
+        buses, = used_buses(results).values()
+        self.assertTrue(
+            any(y != source_hicann.y().value() for _, y, _ in buses))
+
+    def test_parallel_synapse_routing(self):
+        """
+        Synapse routing for different HICANNs can run concurrently and
+        yields the same synapses and synapse switches as serial synapse
+        routing.
+        """
+        hicanns = [C.HICANNOnWafer(Enum(ii)) for ii in [168, 169, 170, 171]]
+
+        def build():
+            source = pynn.Population(1, pynn.IF_cond_exp, {})
+            self.marocco.manual_placement.on_hicann(
+                source, C.HICANNOnWafer(Enum(167)))
+
+            for hicann in hicanns:
+                target = pynn.Population(1, pynn.IF_cond_exp, {})
+                self.marocco.manual_placement.on_hicann(target, hicann)
+                pynn.Projection(
+                    source, target, pynn.AllToAllConnector(weights=0.004))
+
+        # Population ids are not necessarily stable across runs, so
+        # synapses are compared by neuron index and hardware synapse.
+        def synapses(results):
+            return set(
+                (item.source_neuron().neuron_index(),
+                 item.target_neuron().neuron_index(),
+                 item.hardware_synapse())
+                for item in results.synapse_routing.synapses())
+
+        def synapse_switches(results, hicann):
+            return set(
+                (item.source(),
+                 item.connected_drivers().primary_driver(),
+                 item.connected_drivers().size())
+                for item in results.synapse_routing[hicann].synapse_switches())
+
+        self.marocco.synapse_routing.parallel(False)
+        serial = self.map_network(build, "serial")
+
+        self.marocco.synapse_routing.parallel(True)
+        parallel = self.map_network(build, "parallel")
+
+        self.assertEqual(len(hicanns), parallel.synapse_routing.synapses().size())
+        self.assertEqual(synapses(serial), synapses(parallel))
+
+        for hicann in hicanns:
+            self.assertTrue(serial.synapse_routing.has(hicann))
+            self.assertTrue(parallel.synapse_routing.has(hicann))
+            self.assertEqual(
+                synapse_switches(serial, hicann),
+                synapse_switches(parallel, hicann))
+
+    def test_bus_rate_budget(self):
+        """
+        The predicted event rate of each L1 bus is stored in the results.
+        Sources whose estimated event rate exceeds the L1 bus rate budget
+        are not routed if the budget is enforced.
+        """
+        def build():
+            source = pynn.Population(
+                1, pynn.SpikeSourcePoisson, {'rate': 100.})
+            target = pynn.Population(1, pynn.IF_cond_exp, {})
+            pynn.Projection(
+                source, target, pynn.AllToAllConnector(weights=0.004))
+
+            self.marocco.manual_placement.on_hicann(
+                source, C.HICANNOnWafer(Enum(167)))
+            self.marocco.manual_placement.on_hicann(
+                target, C.HICANNOnWafer(Enum(170)))
+
+        rate = 100. * self.marocco.experiment.speedup()
+        self.marocco.l1_routing.bus_rate_budget(rate / 2)
+
+        self.marocco.l1_routing.enforce_bus_rate_budget(False)
+        results = self.map_network(build, "not_enforced")
+
+        self.assertEqual(1, results.synapse_routing.synapses().size())
+        used = set()
+        for item in results.l1_routing:
+            hicann = None
+            for segment in item.route():
+                if isinstance(segment, C.HICANNOnWafer):
+                    hicann = segment
+                elif isinstance(segment, (C.HLineOnHICANN, C.VLineOnHICANN)):
+                    self.assertAlmostEqual(
+                        rate, results.l1_routing.predicted_rate(hicann, segment),
+                        delta=1e-6 * rate)
+                    used.add(str(segment))
+        self.assertTrue(used)
+        unused = next(
+            hline for hline in C.iter_all(C.HLineOnHICANN)
+            if str(hline) not in used)
+        self.assertEqual(
+            0., results.l1_routing.predicted_rate(
+                C.HICANNOnWafer(Enum(167)), unused))
+
+        self.marocco.l1_routing.enforce_bus_rate_budget(True)
+        results = self.map_network(build, "enforced")
+
+        self.assertEqual(0, results.synapse_routing.synapses().size())
+        self.assertEqual(1, self.marocco.stats.getSynapseLossAfterL1Routing())
+
 
 if __name__ == '__main__':
     unittest.main()
@@ -0,0 +1,40 @@
+import math
+import unittest
+
+from pyhalco_hicann_v2 import *
+from pyhalco_common import *
+from pymarocco_results import Congestion
+
+
+class CongestionTest(unittest.TestCase):
+    def test_empty(self):
+        congestion = Congestion()
+        hicann = HICANNOnWafer(Enum(100))
+        self.assertEqual(0., congestion.demand(hicann, horizontal))
+        self.assertEqual(0, congestion.capacity(hicann, vertical))
+        self.assertEqual(0., congestion.utilization(hicann, horizontal))
+        self.assertEqual(0., congestion.max_utilization())
+        self.assertEqual(0, congestion.num_overflowed())
+
+    def test_utilization(self):
+        congestion = Congestion()
+        hicann = HICANNOnWafer(Enum(100))
+        congestion.set_capacity(hicann, horizontal, 64)
+        congestion.add_demand(hicann, horizontal, 16.)
+        congestion.add_demand(hicann, horizontal, 16.)
+        self.assertEqual(32., congestion.demand(hicann, horizontal))
+        self.assertEqual(0.5, congestion.utilization(hicann, horizontal))
+        self.assertEqual(0.5, congestion.max_utilization())
+        self.assertEqual(0., congestion.total_overflow())
+
+        # Demand on HICANNs without capacity can not be routed.
+        other = HICANNOnWafer(Enum(101))
+        congestion.add_demand(other, vertical, 2.)
+        self.assertTrue(math.isinf(congestion.utilization(other, vertical)))
+        self.assertTrue(math.isinf(congestion.max_utilization()))
+        self.assertEqual(2., congestion.total_overflow())
+        self.assertEqual(1, congestion.num_overflowed())
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -1,6 +1,7 @@
 #include "test/common.h"
 
 #include "halco/common/iter_all.h"
+#include "marocco/coordinates/PackedL1Route.h"
 #include "marocco/routing/Configuration.h"
 
 using namespace halco::hicann::v2;
@@ -92,5 +93,43 @@ TEST(RoutingConfiguration, configureWithTestOutput)
 	EXPECT_EQ(hicann2_ref.repeater, hw[hicann2].repeater);
 }
 
+TEST(RoutingConfiguration, configureGivesSameResultForPackedRoutes)
+{
+	HICANNOnWafer const hicann(X(5), Y(5));
+	HLineOnHICANN const hline(0);
+	VLineOnHICANN const vline(8);
+
+	std::vector<L1Route> const routes{
+	    // Horizontal route to the right.
+	    L1Route{hicann, DNCMergerOnHICANN(2), HLineOnHICANN(46), hicann.east(),
+	            HLineOnHICANN(48), VLineOnHICANN(39)},
+	    // Sending repeater driving to the left.
+	    L1Route{hicann, DNCMergerOnHICANN(2), hicann.west(), HLineOnHICANN(46).west()},
+	    // Vertical route to the bottom.
+	    L1Route{hicann, DNCMergerOnHICANN(2), HLineOnHICANN(46), vline, hicann.south(),
+	            vline.south()},
+	    // Switch from vertical to horizontal bus.
+	    L1Route{hicann, VLineOnHICANN(39), HLineOnHICANN(48)},
+	    // Test output via repeater block.
+	    L1Route{hicann, hline.toHRepeaterOnHICANN().toRepeaterBlockOnHICANN(), hline,
+	            hicann.east(), hline.east()}};
+
+	for (auto const& route : routes) {
+		sthal::Wafer unpacked;
+		configure(unpacked, route);
+
+		sthal::Wafer packed;
+		configure(packed, PackedL1Route(route));
+
+		ASSERT_EQ(
+		    unpacked.getAllocatedHicannCoordinates(), packed.getAllocatedHicannCoordinates())
+		    << route;
+		for (auto const& hc : unpacked.getAllocatedHicannCoordinates()) {
+			EXPECT_EQ(unpacked[hc].repeater, packed[hc].repeater) << route;
+			EXPECT_EQ(unpacked[hc].crossbar_switches, packed[hc].crossbar_switches) << route;
+		}
+	}
+}
+
 } // namespace routing
 } // namespace marocco
@@ -0,0 +1,95 @@
+#include "test/common.h"
+
+#include "halco/hicann/v2/hicann.h"
+#include "marocco/routing/L1CorridorPlanner.h"
+
+using namespace halco::hicann::v2;
+using namespace halco::common;
+
+namespace marocco {
+namespace routing {
+
+class AL1CorridorPlanner : public ::testing::Test
+{
+protected:
+	AL1CorridorPlanner()
+	{
+		for (size_t xx = 10; xx < 15; ++xx) {
+			for (size_t yy = 5; yy < 9; ++yy) {
+				routing_graph.add(HICANNOnWafer(X(xx), Y(yy)));
+			}
+		}
+	}
+
+	L1RoutingGraph routing_graph;
+}; // AL1CorridorPlanner
+
+TEST_F(AL1CorridorPlanner, coversSourceAndTargets)
+{
+	L1CorridorPlanner planner(routing_graph, 0);
+	HICANNOnWafer const source(X(10), Y(5));
+	HICANNOnWafer const first(X(14), Y(5));
+	HICANNOnWafer const second(X(10), Y(8));
+
+	auto const region = planner.plan(source, {first, second});
+	EXPECT_TRUE(region.contains(source));
+	EXPECT_TRUE(region.contains(first));
+	EXPECT_TRUE(region.contains(second));
+	// Both targets are attached to the tree via shortest paths on the HICANN grid.
+	EXPECT_EQ(5 + 3, region.size());
+	EXPECT_FALSE(region.contains(HICANNOnWafer(X(14), Y(8))));
+	EXPECT_FALSE(region.contains(HICANNOnWafer(X(3), Y(3))));
+}
+
+TEST_F(AL1CorridorPlanner, widensCorridorByMargin)
+{
+	HICANNOnWafer const source(X(10), Y(6));
+	HICANNOnWafer const target(X(14), Y(6));
+
+	L1CorridorPlanner narrow(routing_graph, 0);
+	EXPECT_EQ(5, narrow.plan(source, {target}).size());
+
+	L1CorridorPlanner wide(routing_graph, 1);
+	auto const region = wide.plan(source, {target});
+	EXPECT_EQ(5 * 3, region.size());
+	EXPECT_TRUE(region.contains(HICANNOnWafer(X(12), Y(5))));
+	EXPECT_TRUE(region.contains(HICANNOnWafer(X(12), Y(7))));
+	EXPECT_FALSE(region.contains(HICANNOnWafer(X(12), Y(8))));
+}
+
+TEST_F(AL1CorridorPlanner, derivesCapacityFromRoutingGraph)
+{
+	HICANNOnWafer const hicann(X(11), Y(6));
+	L1CorridorPlanner planner(routing_graph, 0);
+
+	// Each horizontal bus is connected to the adjacent HICANN by one repeater.
+	EXPECT_EQ(HLineOnHICANN::size, planner.capacity(hicann, hicann.east()));
+	EXPECT_EQ(HLineOnHICANN::size, planner.capacity(hicann.east(), hicann));
+	EXPECT_EQ(VLineOnHICANN::size, planner.capacity(hicann, hicann.south()));
+	EXPECT_EQ(0, planner.capacity(hicann, hicann.east().east()));
+
+	routing_graph.remove(hicann, HLineOnHICANN(0));
+	L1CorridorPlanner updated(routing_graph, 0);
+	EXPECT_EQ(HLineOnHICANN::size - 1, updated.capacity(hicann, hicann.east()));
+}
+
+TEST_F(AL1CorridorPlanner, steersAroundUsedConnections)
+{
+	L1CorridorPlanner planner(routing_graph, 0);
+	HICANNOnWafer const source(X(10), Y(6));
+	HICANNOnWafer const target(X(12), Y(6));
+
+	auto const first = planner.plan(source, {target});
+	EXPECT_EQ(3, first.size());
+
+	// Usage of the direct connections increases their cost, until detours are cheaper.
+	bool detour = false;
+	for (size_t ii = 0; ii < HLineOnHICANN::size && !detour; ++ii) {
+		auto const region = planner.plan(source, {target});
+		detour = !region.contains(HICANNOnWafer(X(11), Y(6)));
+	}
+	EXPECT_TRUE(detour);
+}
+
+} // namespace routing
+} // namespace marocco
@@ -5,7 +5,9 @@
 #include "halco/hicann/v2/hicann.h"
 #include "halco/common/iter_all.h"
 #include "marocco/routing/L1DijkstraRouter.h"
+#include "marocco/routing/L1EdgeWeights.h"
 #include "marocco/routing/L1Routing.h"
+#include "marocco/routing/RoutingRegion.h"
 
 using namespace halco::hicann::v2;
 using namespace halco::common;
@@ -220,5 +222,109 @@ TEST_F(AL1DijkstraRouter, doesNotUseMoreThanOneSwitchPerBusSameHICANN)
 	EXPECT_EQ(reference, route);
 }
 
+TEST_F(AL1DijkstraRouter, findsSubsetOfCandidatesWhenTerminatingEarly)
+{
+	HICANNOnWafer hicann1(X(5), Y(5));
+	HICANNOnWafer hicann2(X(9), Y(7));
+	L1EdgeWeights weights(routing_graph.graph());
+	auto const source = routing_graph[hicann1][SendingRepeaterOnHICANN(3).toHLineOnHICANN()];
+	Target target(hicann2, vertical);
+
+	L1DijkstraRouter early(weights, source);
+	L1DijkstraRouter exhaustive(
+	    weights, source, L1DijkstraRouter::SwitchExclusiveness::global,
+	    L1DijkstraRouter::Termination::exhaustive);
+	for (auto* dijkstra : {&early, &exhaustive}) {
+		dijkstra->add_target(target);
+		dijkstra->run();
+	}
+
+	auto const& candidates = exhaustive.vertices_for(target);
+	ASSERT_FALSE(early.vertices_for(target).empty());
+	EXPECT_LE(early.vertices_for(target).size(), candidates.size());
+	for (auto const& vertex : early.vertices_for(target)) {
+		EXPECT_NE(candidates.end(), candidates.find(vertex));
+		EXPECT_EQ(exhaustive.path_to(vertex).size(), early.path_to(vertex).size());
+	}
+}
+
+TEST_F(AL1DijkstraRouter, guidesSearchForSingleTarget)
+{
+	HICANNOnWafer hicann1(X(5), Y(5));
+	HICANNOnWafer hicann2(X(20), Y(10));
+	L1EdgeWeights weights(routing_graph.graph());
+	auto const source = routing_graph[hicann1][SendingRepeaterOnHICANN(3).toHLineOnHICANN()];
+	Target target(hicann2, vertical);
+	// Registering a second target (reached immediately) disables the guided search.
+	Target nearby(hicann1, vertical);
+
+	auto const num_finished = [](RoutingWorkspace const& workspace) {
+		size_t count = 0;
+		for (size_t vertex = 0; vertex < workspace.size(); ++vertex) {
+			if (workspace.is_finished(vertex)) {
+				++count;
+			}
+		}
+		return count;
+	};
+
+	RoutingWorkspace guided_workspace;
+	L1DijkstraRouter guided(
+	    weights, source, L1DijkstraRouter::SwitchExclusiveness::global,
+	    L1DijkstraRouter::Termination::all_targets_reached, guided_workspace);
+	guided.add_target(target);
+	guided.run();
+
+	RoutingWorkspace plain_workspace;
+	L1DijkstraRouter plain(
+	    weights, source, L1DijkstraRouter::SwitchExclusiveness::global,
+	    L1DijkstraRouter::Termination::all_targets_reached, plain_workspace);
+	plain.add_target(target);
+	plain.add_target(nearby);
+	plain.run();
+
+	ASSERT_FALSE(guided.vertices_for(target).empty());
+	ASSERT_FALSE(plain.vertices_for(target).empty());
+	auto const guided_vertex = *guided.vertices_for(target).begin();
+	auto const plain_vertex = *plain.vertices_for(target).begin();
+	EXPECT_EQ(plain_workspace.distance(plain_vertex), guided_workspace.distance(guided_vertex));
+	EXPECT_EQ(plain.path_to(plain_vertex).size(), guided.path_to(guided_vertex).size());
+	EXPECT_LT(num_finished(guided_workspace), num_finished(plain_workspace));
+}
+
+TEST_F(AL1DijkstraRouter, canBeRestrictedToRegion)
+{
+	HICANNOnWafer const hicann(X(10), Y(6));
+	L1EdgeWeights weights(routing_graph.graph());
+	auto const source = routing_graph[hicann][HLineOnHICANN(4)];
+	Target const target(hicann.south().east(), vertical);
+
+	RoutingRegion region(routing_graph);
+	region.add(hicann);
+	region.add(hicann.south());
+	region.add(hicann.south().east());
+	EXPECT_FALSE(region.contains(routing_graph[hicann.east()][VLineOnHICANN(0)]));
+
+	L1DijkstraRouter dijkstra(weights, source);
+	dijkstra.restrict_to(region);
+	dijkstra.add_target(target);
+	dijkstra.run();
+
+	auto const& vertices = dijkstra.vertices_for(target);
+	ASSERT_FALSE(vertices.empty());
+	for (auto const vertex : dijkstra.path_to(*vertices.begin())) {
+		EXPECT_TRUE(region.contains(vertex));
+	}
+
+	RoutingRegion excluding_target(routing_graph);
+	excluding_target.add(hicann);
+	excluding_target.add(hicann.east());
+	L1DijkstraRouter restricted(weights, source);
+	restricted.restrict_to(excluding_target);
+	restricted.add_target(target);
+	restricted.run();
+	EXPECT_TRUE(restricted.vertices_for(target).empty());
+}
+
 } // routing
 } // marocco
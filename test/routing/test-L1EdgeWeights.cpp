@@ -0,0 +1,115 @@
+#include "test/common.h"
+
+#include "halco/hicann/v2/hicann.h"
+#include "marocco/routing/L1EdgeWeights.h"
+#include "marocco/util/iterable.h"
+
+using namespace halco::hicann::v2;
+using namespace halco::common;
+
+namespace marocco {
+namespace routing {
+
+class AL1EdgeWeights : public ::testing::Test
+{
+protected:
+	AL1EdgeWeights()
+	{
+		routing_graph.add(hicann);
+		routing_graph.add(hicann.east());
+	}
+
+	L1RoutingGraph::edge_descriptor some_edge() const
+	{
+		auto const& graph = routing_graph.graph();
+		return *boost::out_edges(routing_graph[hicann][HLineOnHICANN(0)], graph).first;
+	}
+
+	HICANNOnWafer const hicann{X(5), Y(5)};
+	L1RoutingGraph routing_graph;
+}; // AL1EdgeWeights
+
+TEST_F(AL1EdgeWeights, defaultsToUnitWeight)
+{
+	L1EdgeWeights weights(routing_graph.graph());
+	auto const& graph = routing_graph.graph();
+	for (auto const& edge : make_iterable(edges(graph))) {
+		ASSERT_EQ(1, weights.weight(edge));
+	}
+}
+
+TEST_F(AL1EdgeWeights, usesMaximumVertexWeightUnlessEdgeWeightIsSet)
+{
+	L1EdgeWeights weights(routing_graph.graph());
+	auto const& graph = routing_graph.graph();
+	auto const edge = some_edge();
+
+	weights.set_weights(
+	    std::vector<L1RoutingGraph::vertex_descriptor>{source(edge, graph), target(edge, graph)},
+	    5);
+	weights.set_weight(target(edge, graph), 7);
+	EXPECT_EQ(7, weights.weight(edge));
+
+	weights.set_weight(edge, 3);
+	EXPECT_EQ(3, weights.weight(edge));
+}
+
+TEST_F(AL1EdgeWeights, appliesEdgeWeightsToBothDirections)
+{
+	L1EdgeWeights weights(routing_graph.graph());
+	auto const& graph = routing_graph.graph();
+	auto const edge = some_edge();
+	weights.set_weight(edge, 42);
+
+	auto const reverse = boost::edge(target(edge, graph), source(edge, graph), graph);
+	ASSERT_TRUE(reverse.second);
+	EXPECT_EQ(42, weights.weight(reverse.first));
+}
+
+TEST_F(AL1EdgeWeights, canBeReset)
+{
+	L1EdgeWeights weights(routing_graph.graph());
+	auto const& graph = routing_graph.graph();
+	auto const edge = some_edge();
+	weights.set_weight(edge, 42);
+	weights.set_weight(source(edge, graph), 23);
+
+	weights.reset();
+	EXPECT_EQ(1, weights.weight(edge));
+
+	weights.set_weight(target(edge, graph), 5);
+	EXPECT_EQ(5, weights.weight(edge));
+}
+
+TEST_F(AL1EdgeWeights, rejectsInvalidWeights)
+{
+	L1EdgeWeights weights(routing_graph.graph());
+	auto const edge = some_edge();
+	EXPECT_THROW(weights.set_weight(edge, 0), std::invalid_argument);
+	EXPECT_THROW(weights.set_weight(edge, L1EdgeWeights::max_weight() + 1), std::out_of_range);
+	EXPECT_NO_THROW(weights.set_weight(edge, L1EdgeWeights::max_weight()));
+}
+
+TEST_F(AL1EdgeWeights, boundsEffectiveWeightsFromBelow)
+{
+	L1EdgeWeights weights(routing_graph.graph());
+	auto const& graph = routing_graph.graph();
+	EXPECT_EQ(1, weights.min_weight());
+
+	// Vertex weights only raise the bound if they have been set for all vertices.
+	weights.set_weight(source(some_edge(), graph), 23);
+	EXPECT_EQ(1, weights.min_weight());
+	for (auto const vertex : make_iterable(vertices(graph))) {
+		weights.set_weight(vertex, 7);
+	}
+	EXPECT_EQ(7, weights.min_weight());
+
+	weights.set_weight(some_edge(), 3);
+	EXPECT_EQ(3, weights.min_weight());
+
+	weights.reset();
+	EXPECT_EQ(1, weights.min_weight());
+}
+
+} // namespace routing
+} // namespace marocco
@@ -279,5 +279,36 @@ TEST_F(AL1GraphWalker, DetourDoesNotWalkBeyondLimitIfAlreadyExceeded)
 	EXPECT_TRUE(path.empty());
 }
 
+TEST(L1GraphWalker, recomputesWalksAfterInvalidation)
+{
+	HICANNOnWafer hicann(X(8), Y(5));
+	L1RoutingGraph rgraph;
+	rgraph.add(hicann);
+	rgraph.add(hicann.east());
+	rgraph.add(hicann.east().east());
+	L1GraphWalker walker(rgraph.graph());
+
+	auto const vertex = rgraph[hicann][HLineOnHICANN(32)];
+	L1GraphWalker::path_type path;
+	bool reached_limit;
+	std::tie(path, reached_limit) = walker.walk(vertex, east, 10);
+	EXPECT_TRUE(reached_limit);
+	ASSERT_EQ(2, path.size());
+
+	// Memoized walks are returned as long as no vertex of the walk has been invalidated.
+	auto const unrelated = rgraph[hicann.east()][HLineOnHICANN(3)];
+	PathBundle const other(PathBundle::path_type{unrelated});
+	rgraph.remove(other);
+	walker.invalidate(other);
+	EXPECT_EQ(std::make_pair(path, true), walker.walk(vertex, east, 10));
+
+	PathBundle const bundle(PathBundle::path_type{path.front()});
+	rgraph.remove(bundle);
+	walker.invalidate(bundle);
+	std::tie(path, reached_limit) = walker.walk(vertex, east, 10);
+	EXPECT_FALSE(reached_limit);
+	EXPECT_TRUE(path.empty());
+}
+
 } // routing
 } // marocco
@@ -0,0 +1,162 @@
+#include "test/common.h"
+
+#include <map>
+#include <random>
+#include <vector>
+
+#include "halco/common/iter_all.h"
+#include "marocco/routing/L1ReachabilityIndex.h"
+#include "marocco/routing/L1RoutingGraph.h"
+#include "marocco/routing/PathBundle.h"
+#include "marocco/util/iterable.h"
+
+using namespace halco::hicann::v2;
+using namespace halco::common;
+
+namespace marocco {
+namespace routing {
+
+namespace {
+
+/**
+ * @brief Checks that both indices partition the vertices in the same way.
+ */
+void expect_same_partition(
+    L1ReachabilityIndex const& lhs, L1ReachabilityIndex const& rhs, size_t num_vertices)
+{
+	std::map<L1ReachabilityIndex::component_type, L1ReachabilityIndex::component_type> mapping;
+	for (L1RoutingGraph::vertex_descriptor vertex = 0; vertex < num_vertices; ++vertex) {
+		auto const left = lhs.component(vertex);
+		auto const right = rhs.component(vertex);
+		EXPECT_EQ(left == L1ReachabilityIndex::removed(), right == L1ReachabilityIndex::removed());
+		auto it = mapping.insert(std::make_pair(left, right)).first;
+		EXPECT_EQ(it->second, right);
+	}
+}
+
+} // namespace
+
+TEST(L1ReachabilityIndex, findsTargetsInSameComponent)
+{
+	L1RoutingGraph rgraph;
+	HICANNOnWafer const hicann(X(5), Y(5));
+	HICANNOnWafer const other(X(8), Y(5));
+	rgraph.add(hicann);
+	rgraph.add(hicann.east());
+	rgraph.add(other);
+
+	L1ReachabilityIndex index(rgraph);
+	auto const source = rgraph[hicann][HLineOnHICANN(46)];
+	EXPECT_TRUE(index.reachable(source, Target(hicann, vertical)));
+	EXPECT_TRUE(index.reachable(source, Target(hicann.east(), vertical)));
+	EXPECT_TRUE(index.reachable(source, Target(hicann.east(), horizontal)));
+	// HICANN at X(8) is not adjacent.
+	EXPECT_FALSE(index.reachable(source, Target(other, vertical)));
+}
+
+TEST(L1ReachabilityIndex, splitsComponentsWhenRemovingBuses)
+{
+	L1RoutingGraph rgraph;
+	HICANNOnWafer const hicann(X(5), Y(5));
+	rgraph.add(hicann);
+	rgraph.add(hicann.east());
+
+	L1ReachabilityIndex index(rgraph);
+	auto const source = rgraph[hicann][HLineOnHICANN(46)];
+	ASSERT_TRUE(index.reachable(source, Target(hicann.east(), vertical)));
+
+	// Remove all buses of the east HICANN that are adjacent to the source bus, as well as
+	// all vertical buses of the source HICANN.
+	std::vector<L1RoutingGraph::vertex_descriptor> removed;
+	for (auto const vertex : make_iterable(adjacent_vertices(source, rgraph.graph()))) {
+		if (rgraph[vertex].toHICANNOnWafer() == hicann.east()) {
+			removed.push_back(vertex);
+		}
+	}
+	for (auto const vline : iter_all<VLineOnHICANN>()) {
+		removed.push_back(rgraph[hicann][vline]);
+	}
+	for (auto const vertex : removed) {
+		PathBundle const bundle(PathBundle::path_type{vertex});
+		rgraph.remove(bundle);
+		index.update(bundle);
+	}
+
+	EXPECT_FALSE(index.reachable(source, Target(hicann, vertical)));
+	EXPECT_FALSE(index.reachable(source, Target(hicann.east(), vertical)));
+	EXPECT_EQ(L1ReachabilityIndex::removed(), index.component(rgraph[hicann][VLineOnHICANN(3)]));
+
+	// Updated index agrees with an index built from scratch.
+	L1ReachabilityIndex fresh(rgraph);
+	expect_same_partition(index, fresh, num_vertices(rgraph.graph()));
+}
+
+TEST(L1ReachabilityIndex, agreesWithFreshIndexAfterRandomRemovals)
+{
+	L1RoutingGraph rgraph;
+	HICANNOnWafer const hicann(X(5), Y(5));
+	rgraph.add(hicann);
+	rgraph.add(hicann.east());
+	rgraph.add(hicann.south());
+	rgraph.add(hicann.south().east());
+
+	L1ReachabilityIndex index(rgraph);
+	size_t const num = num_vertices(rgraph.graph());
+	std::mt19937 gen(42);
+	for (size_t step = 0; step < 40; ++step) {
+		// Remove a short random walk, which resembles a route.
+		PathBundle::path_type path{gen() % num};
+		for (size_t ii = 0; ii < 4; ++ii) {
+			std::vector<L1RoutingGraph::vertex_descriptor> next;
+			for (auto const vertex :
+			     make_iterable(adjacent_vertices(path.back(), rgraph.graph()))) {
+				next.push_back(vertex);
+			}
+			if (next.empty()) {
+				break;
+			}
+			path.push_back(next[gen() % next.size()]);
+		}
+		PathBundle const bundle(path);
+		rgraph.remove(bundle);
+		index.update(bundle);
+
+		L1ReachabilityIndex fresh(rgraph);
+		expect_same_partition(index, fresh, num);
+	}
+}
+
+TEST(L1ReachabilityIndex, keepsLabelOfRemainingPart)
+{
+	L1RoutingGraph rgraph;
+	HICANNOnWafer const hicann(X(5), Y(5));
+	rgraph.add(hicann);
+	rgraph.add(hicann.east());
+
+	L1ReachabilityIndex index(rgraph);
+	auto const bus = rgraph[hicann.east()][VLineOnHICANN(7)];
+	auto const component = index.component(bus);
+
+	PathBundle const bundle(PathBundle::path_type{rgraph[hicann][HLineOnHICANN(46)]});
+	rgraph.remove(bundle);
+	index.update(bundle);
+	EXPECT_EQ(component, index.component(bus));
+}
+
+TEST(L1ReachabilityIndex, treatsRemovedSourceAsUnreachable)
+{
+	L1RoutingGraph rgraph;
+	HICANNOnWafer const hicann(X(5), Y(5));
+	rgraph.add(hicann);
+
+	L1ReachabilityIndex index(rgraph);
+	auto const source = rgraph[hicann][HLineOnHICANN(46)];
+	PathBundle const bundle(PathBundle::path_type{source});
+	rgraph.remove(bundle);
+	index.update(bundle);
+
+	EXPECT_FALSE(index.reachable(source, Target(hicann, vertical)));
+}
+
+} // namespace routing
+} // namespace marocco
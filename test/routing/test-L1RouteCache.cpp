@@ -0,0 +1,123 @@
+#include "test/common.h"
+
+#include <boost/filesystem.hpp>
+
+#include "halco/hicann/v2/l1.h"
+#include "marocco/routing/L1RouteCache.h"
+
+using namespace halco::hicann::v2;
+using namespace halco::common;
+
+namespace marocco {
+namespace routing {
+
+namespace {
+
+class L1RouteCacheTest : public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		directory = boost::filesystem::temp_directory_path() /
+		            boost::filesystem::unique_path("marocco-test-%%%%-%%%%-%%%%");
+	}
+
+	void TearDown() override
+	{
+		boost::filesystem::remove_all(directory);
+	}
+
+	boost::filesystem::path directory;
+	parameters::L1Routing parameters;
+};
+
+size_t const num_vertices = 1000;
+
+} // namespace
+
+TEST_F(L1RouteCacheTest, isDisabledForEmptyDirectory)
+{
+	L1RouteCache cache("", 0, parameters);
+	EXPECT_FALSE(cache.enabled());
+	EXPECT_FALSE(cache.load(num_vertices));
+}
+
+TEST_F(L1RouteCacheTest, findsEntriesForSameSourceAndTargets)
+{
+	L1RouteCache cache(directory.string(), 42, parameters);
+	DNCMergerOnWafer const source(DNCMergerOnHICANN(3), HICANNOnWafer(Enum(100)));
+	L1RouteCache::targets_type const targets{HICANNOnWafer(Enum(101)), HICANNOnWafer(Enum(102))};
+	L1RouteCache::paths_type const paths{{1, 2, 3}, {1, 4}};
+
+	EXPECT_EQ(nullptr, cache.find(source, targets));
+	EXPECT_THROW(cache.insert(source, targets, {{1, 2, 3}}), std::invalid_argument);
+	cache.insert(source, targets, paths);
+	ASSERT_NE(nullptr, cache.find(source, targets));
+	EXPECT_EQ(paths, *cache.find(source, targets));
+
+	EXPECT_EQ(nullptr, cache.find(source, {HICANNOnWafer(Enum(101))}));
+	DNCMergerOnWafer const other(DNCMergerOnHICANN(4), HICANNOnWafer(Enum(100)));
+	EXPECT_EQ(nullptr, cache.find(other, targets));
+}
+
+TEST_F(L1RouteCacheTest, restoresStoredEntries)
+{
+	DNCMergerOnWafer const source(DNCMergerOnHICANN(3), HICANNOnWafer(Enum(100)));
+	L1RouteCache::targets_type const targets{HICANNOnWafer(Enum(101)), HICANNOnWafer(Enum(102))};
+	L1RouteCache::paths_type const paths{{1, 2, 3}, {}};
+
+	{
+		L1RouteCache cache(directory.string(), 42, parameters);
+		EXPECT_FALSE(cache.load(num_vertices));
+		cache.insert(source, targets, paths);
+		cache.store();
+	}
+
+	L1RouteCache cache(directory.string(), 42, parameters);
+	ASSERT_TRUE(cache.load(num_vertices));
+	EXPECT_EQ(1, cache.size());
+	ASSERT_NE(nullptr, cache.find(source, targets));
+	EXPECT_EQ(paths, *cache.find(source, targets));
+
+	// Vertex descriptors out of range invalidate the whole file.
+	L1RouteCache smaller(directory.string(), 42, parameters);
+	EXPECT_FALSE(smaller.load(3));
+	EXPECT_EQ(0, smaller.size());
+}
+
+TEST_F(L1RouteCacheTest, separatesGraphsAndParameters)
+{
+	DNCMergerOnWafer const source(DNCMergerOnHICANN(3), HICANNOnWafer(Enum(100)));
+	L1RouteCache::targets_type const targets{HICANNOnWafer(Enum(101))};
+
+	L1RouteCache cache(directory.string(), 42, parameters);
+	cache.insert(source, targets, {{1, 2}});
+	cache.store();
+
+	L1RouteCache other_graph(directory.string(), 43, parameters);
+	EXPECT_NE(cache.path(), other_graph.path());
+	EXPECT_FALSE(other_graph.load(num_vertices));
+
+	parameters.algorithm(parameters::L1Routing::Algorithm::dijkstra);
+	L1RouteCache other_parameters(directory.string(), 42, parameters);
+	EXPECT_NE(cache.path(), other_parameters.path());
+	EXPECT_FALSE(other_parameters.load(num_vertices));
+}
+
+TEST_F(L1RouteCacheTest, ignoresTruncatedFiles)
+{
+	DNCMergerOnWafer const source(DNCMergerOnHICANN(3), HICANNOnWafer(Enum(100)));
+	L1RouteCache cache(directory.string(), 42, parameters);
+	cache.insert(source, {HICANNOnWafer(Enum(101))}, {{1, 2, 3, 4}});
+	cache.store();
+
+	auto const size = boost::filesystem::file_size(cache.path());
+	boost::filesystem::resize_file(cache.path(), size - 4);
+
+	L1RouteCache restored(directory.string(), 42, parameters);
+	EXPECT_FALSE(restored.load(num_vertices));
+	EXPECT_EQ(0, restored.size());
+}
+
+} // namespace routing
+} // namespace marocco
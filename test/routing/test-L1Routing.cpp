@@ -72,5 +72,39 @@ TEST(L1Routing, with_dnc_merger_prefix)
 	EXPECT_ANY_THROW(with_dnc_merger_prefix(head, DNCMergerOnWafer(DNCMergerOnHICANN(1), hicann)));
 }
 
+TEST(L1Routing, rejectsCachedRoutesCrossingSendingRepeatersOfOtherSources)
+{
+	L1RoutingGraph rgraph;
+	HICANNOnWafer const hicann(X(5), Y(5));
+	rgraph.add(hicann);
+	rgraph.add(hicann.east());
+
+	// Both sources drive horizontal buses on the same HICANN.
+	auto const own = DNCMergerOnWafer(DNCMergerOnHICANN(3), hicann);
+	auto const other = DNCMergerOnWafer(DNCMergerOnHICANN(5), hicann);
+	auto const own_bus = rgraph[hicann][own.toSendingRepeaterOnHICANN().toHLineOnHICANN()];
+	auto const other_bus = rgraph[hicann][other.toSendingRepeaterOnHICANN().toHLineOnHICANN()];
+	std::unordered_set<L1RoutingGraph::vertex_descriptor> const sending_repeaters{
+	    own_bus, other_bus};
+
+	// Cached route of the first source that only uses its own sending repeater bus.
+	std::vector<PathBundle::path_type> paths{
+	    {own_bus, rgraph[hicann.east()][HLineOnHICANN(48)],
+	     rgraph[hicann.east()][VLineOnHICANN(39)]}};
+	EXPECT_FALSE(crosses_sending_repeater_buses(paths, sending_repeaters));
+
+	// Cached route of the first source that passes the bus of the other source.
+	paths.push_back({own_bus, rgraph[hicann][VLineOnHICANN(7)], other_bus});
+	EXPECT_TRUE(crosses_sending_repeater_buses(paths, sending_repeaters));
+
+	// Routes starting at the bus of the other source are routes of the other source.
+	paths.back() = {other_bus, rgraph[hicann][VLineOnHICANN(7)]};
+	EXPECT_FALSE(crosses_sending_repeater_buses(paths, sending_repeaters));
+
+	// Empty paths (failed routes) do not cross any bus.
+	paths.back().clear();
+	EXPECT_FALSE(crosses_sending_repeater_buses(paths, sending_repeaters));
+}
+
 } // namespace routing
 } // namespace marocco
@@ -17,9 +17,12 @@ namespace routing {
 TEST(L1RoutingGraph, providesAccessToBoostGraph)
 {
 	L1RoutingGraph rgraph;
-	L1RoutingGraph::graph_type& bgraph = rgraph.graph();
-	L1RoutingGraph::vertex_descriptor vertex = add_vertex(bgraph);
-	remove_vertex(vertex, bgraph);
+	L1RoutingGraph::graph_type const& bgraph = rgraph.graph();
+	EXPECT_EQ(0, num_vertices(bgraph));
+	rgraph.add(HICANNOnWafer());
+	EXPECT_EQ(VLineOnHICANN::size + HLineOnHICANN::size, num_vertices(rgraph.graph()));
+	// The view returned earlier refers to the rebuilt storage.
+	EXPECT_EQ(VLineOnHICANN::size + HLineOnHICANN::size, num_vertices(bgraph));
 }
 
 TEST(L1RoutingGraph, doesNotContainAllHICANNsByDefault)
@@ -199,6 +202,50 @@ TEST(L1RoutingGraph, allowsRemovalOfRealizedPath)
 	EXPECT_EQ(0, out_degree(vline_vertex, rgraph.graph()));
 }
 
+TEST(L1RoutingGraph, keepsStructureWhenRemovingPaths)
+{
+	L1RoutingGraph rgraph;
+	HICANNOnWafer hicann;
+	rgraph.add(hicann);
+	auto const n_edges = num_edges(rgraph.graph());
+	HLineOnHICANN hline(48);
+	VLineOnHICANN vline(39);
+	PathBundle bundle(PathBundle::path_type{rgraph[hicann][hline], rgraph[hicann][vline]});
+	rgraph.remove(bundle);
+	EXPECT_EQ(n_edges, num_edges(rgraph.graph()));
+	EXPECT_TRUE(rgraph.is_removed(rgraph[hicann][hline]));
+	EXPECT_TRUE(rgraph.is_removed(rgraph[hicann][vline]));
+	EXPECT_FALSE(rgraph.is_removed(rgraph[hicann][HLineOnHICANN(12)]));
+	EXPECT_EQ(L1BusOnWafer(hicann, hline), rgraph.graph()[rgraph[hicann][hline]]);
+}
+
+TEST(L1RoutingGraph, keepsRemovedElementsWhenAddingHICANNs)
+{
+	L1RoutingGraph rgraph;
+	HICANNOnWafer hicann_left(X(5), Y(5));
+	HICANNOnWafer hicann_right(X(6), Y(5));
+	rgraph.add(hicann_left);
+	HLineOnHICANN hline(39);
+	rgraph.remove(hicann_left, hline);
+	rgraph.add(hicann_right);
+	EXPECT_EQ(0, out_degree(rgraph[hicann_left][hline], rgraph.graph()));
+	EXPECT_LT(0, out_degree(rgraph[hicann_right][hline.east()], rgraph.graph()));
+}
+
+TEST(L1RoutingGraph, copiesAreIndependent)
+{
+	L1RoutingGraph rgraph;
+	HICANNOnWafer hicann;
+	rgraph.add(hicann);
+	HLineOnHICANN hline(39);
+	L1RoutingGraph copy = rgraph;
+	copy.remove(hicann, hline);
+	EXPECT_EQ(0, out_degree(copy[hicann][hline], copy.graph()));
+	EXPECT_LT(0, out_degree(rgraph[hicann][hline], rgraph.graph()));
+	rgraph = copy;
+	EXPECT_EQ(0, out_degree(rgraph[hicann][hline], rgraph.graph()));
+}
+
 TEST(L1RoutingGraph, allowsDisablingOfDefectHLines)
 {
 	L1RoutingGraph rgraph;
@@ -264,5 +311,78 @@ TEST(L1RoutingGraph, allowsDisablingOfDefectVRepeaters)
 	ASSERT_FALSE(edge_present);
 }
 
+TEST(L1RoutingGraph, disablesDefectsInBulk)
+{
+	HICANNOnWafer hicann_left(X(5), Y(5));
+	HICANNOnWafer hicann_right(X(6), Y(5));
+	HLineOnHICANN hline(39);
+	VLineOnHICANN vline(42);
+	HRepeaterOnHICANN hrep(Enum(12));
+
+	L1RoutingGraph expected;
+	L1RoutingGraph rgraph;
+	for (auto* graph : {&expected, &rgraph}) {
+		graph->add(hicann_left);
+		graph->add(hicann_right);
+	}
+
+	// Use an arbitrary crossbar switch that is present in the graph.
+	auto const crossbar_hline = HLineOnHICANN(10);
+	auto const vertex = rgraph[hicann_left][crossbar_hline];
+	auto const crossbar_vline = [&]() {
+		for (auto const other : make_iterable(adjacent_vertices(vertex, rgraph.graph()))) {
+			if (rgraph[other].is_vertical()) {
+				return rgraph[other].toVLineOnHICANN();
+			}
+		}
+		throw std::runtime_error("no crossbar switch found");
+	}();
+	CrossbarSwitchOnHICANN const cs(X(crossbar_vline.value()), Y(crossbar_hline.value()));
+
+	expected.remove(hicann_left, hline);
+	expected.remove(hicann_right, vline);
+	expected.remove(hicann_right, hrep);
+	expected.remove(hicann_left, cs);
+
+	L1RoutingGraph::DefectMask mask(rgraph);
+	mask.disable(hicann_left, hline);
+	mask.disable(hicann_left, hline);
+	mask.disable(hicann_right, vline);
+	mask.disable(hicann_right, hrep);
+	// Repeater towards a HICANN that is not part of the graph.
+	mask.disable(hicann_left, hrep);
+	mask.disable(hicann_left, cs);
+
+	// Elements are only disabled when applying the mask.
+	EXPECT_FALSE(rgraph.is_removed(rgraph[hicann_left][hline]));
+	rgraph.remove(mask);
+	EXPECT_TRUE(rgraph.is_removed(rgraph[hicann_left][hline]));
+
+	typedef std::pair<L1RoutingGraph::vertex_descriptor, L1RoutingGraph::vertex_descriptor>
+	    edge_type;
+	std::set<edge_type> expected_edges;
+	for (auto const& edge : make_iterable(edges(expected.graph()))) {
+		expected_edges.insert(
+		    std::make_pair(source(edge, expected.graph()), target(edge, expected.graph())));
+	}
+	std::set<edge_type> actual_edges;
+	for (auto const& edge : make_iterable(edges(rgraph.graph()))) {
+		actual_edges.insert(
+		    std::make_pair(source(edge, rgraph.graph()), target(edge, rgraph.graph())));
+	}
+	EXPECT_EQ(expected_edges, actual_edges);
+
+	auto const& counts = mask.counts();
+	EXPECT_EQ(1, counts.hbuses);
+	EXPECT_EQ(1, counts.vbuses);
+	EXPECT_EQ(1, counts.hrepeaters);
+	EXPECT_EQ(0, counts.vrepeaters);
+	EXPECT_EQ(1, counts.crossbar_switches);
+
+	// Adding HICANNs invalidates the mask.
+	rgraph.add(hicann_right.east());
+	EXPECT_THROW(rgraph.remove(mask), std::invalid_argument);
+}
+
 } // namespace routing
 } // namespace marocco
@@ -0,0 +1,190 @@
+#include "test/common.h"
+
+#include <fstream>
+#include <set>
+#include <tuple>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include "halco/hicann/v2/fwd.h"
+#include "halco/common/iter_all.h"
+#include "marocco/routing/L1RoutingGraphCache.h"
+#include "marocco/util/iterable.h"
+
+using namespace halco::hicann::v2;
+using namespace halco::common;
+
+namespace marocco {
+namespace routing {
+
+namespace {
+
+typedef std::tuple<
+    L1RoutingGraph::vertex_descriptor, L1RoutingGraph::vertex_descriptor,
+    L1RoutingGraph::edge_index_type>
+    edge_tuple_type;
+
+std::set<edge_tuple_type> edges_of(L1RoutingGraph const& rgraph)
+{
+	std::set<edge_tuple_type> result;
+	auto const& graph = rgraph.graph();
+	for (auto const& edge : make_iterable(edges(graph))) {
+		result.insert(
+		    std::make_tuple(
+		        source(edge, graph), target(edge, graph),
+		        L1RoutingGraph::edge_index(graph, edge)));
+	}
+	return result;
+}
+
+class L1RoutingGraphCacheTest : public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		directory = boost::filesystem::temp_directory_path() /
+		            boost::filesystem::unique_path("marocco-test-%%%%-%%%%-%%%%");
+	}
+
+	void TearDown() override
+	{
+		boost::filesystem::remove_all(directory);
+	}
+
+	boost::filesystem::path directory;
+};
+
+} // namespace
+
+TEST_F(L1RoutingGraphCacheTest, isDisabledForEmptyDirectory)
+{
+	L1RoutingGraphCache cache("");
+	EXPECT_FALSE(cache.enabled());
+
+	L1RoutingGraph rgraph;
+	rgraph.add(HICANNOnWafer());
+	cache.store(0, rgraph);
+
+	L1RoutingGraph restored;
+	EXPECT_FALSE(cache.load(0, {HICANNOnWafer()}, restored));
+}
+
+TEST_F(L1RoutingGraphCacheTest, restoresStructureAndRemovedElements)
+{
+	L1RoutingGraphCache cache(directory.string());
+	ASSERT_TRUE(cache.enabled());
+
+	HICANNOnWafer const hicann(X(5), Y(5));
+	std::vector<HICANNOnWafer> const hicanns{hicann, hicann.east(), hicann.south()};
+	L1RoutingGraph rgraph;
+	for (auto const& hc : hicanns) {
+		rgraph.add(hc);
+	}
+	rgraph.remove(hicann, HLineOnHICANN(3));
+	rgraph.remove(hicann.south(), VLineOnHICANN(42));
+
+	L1RoutingGraph restored;
+	EXPECT_FALSE(cache.load(1234, hicanns, restored));
+	cache.store(1234, rgraph);
+	ASSERT_TRUE(cache.load(1234, hicanns, restored));
+
+	EXPECT_EQ(num_vertices(rgraph.graph()), num_vertices(restored.graph()));
+	EXPECT_EQ(rgraph.num_edge_indices(), restored.num_edge_indices());
+	EXPECT_EQ(edges_of(rgraph), edges_of(restored));
+
+	for (auto const& hc : hicanns) {
+		for (auto hline : iter_all<HLineOnHICANN>()) {
+			EXPECT_EQ(rgraph[hc][hline], restored[hc][hline]);
+		}
+		for (auto vline : iter_all<VLineOnHICANN>()) {
+			EXPECT_EQ(rgraph[hc][vline], restored[hc][vline]);
+		}
+	}
+	EXPECT_TRUE(restored.is_removed(restored[hicann][HLineOnHICANN(3)]));
+	EXPECT_TRUE(restored.is_removed(restored[hicann.south()][VLineOnHICANN(42)]));
+
+	// Restored graphs can be modified independently.
+	restored.remove(hicann.east(), HLineOnHICANN(7));
+	EXPECT_NE(edges_of(rgraph), edges_of(restored));
+}
+
+TEST_F(L1RoutingGraphCacheTest, ignoresEntriesForOtherKeys)
+{
+	L1RoutingGraphCache cache(directory.string());
+
+	L1RoutingGraph rgraph;
+	rgraph.add(HICANNOnWafer());
+	cache.store(1, rgraph);
+	boost::filesystem::copy_file(cache.path(1), cache.path(2));
+
+	L1RoutingGraph restored;
+	EXPECT_FALSE(cache.load(2, {HICANNOnWafer()}, restored));
+	EXPECT_EQ(0, num_vertices(restored.graph()));
+}
+
+TEST_F(L1RoutingGraphCacheTest, ignoresTruncatedEntries)
+{
+	L1RoutingGraphCache cache(directory.string());
+
+	L1RoutingGraph rgraph;
+	rgraph.add(HICANNOnWafer());
+	cache.store(1, rgraph);
+	auto const size = boost::filesystem::file_size(cache.path(1));
+	boost::filesystem::resize_file(cache.path(1), size / 2);
+
+	L1RoutingGraph restored;
+	EXPECT_FALSE(cache.load(1, {HICANNOnWafer()}, restored));
+	EXPECT_EQ(0, num_vertices(restored.graph()));
+}
+
+TEST_F(L1RoutingGraphCacheTest, ignoresCorruptedEntries)
+{
+	L1RoutingGraphCache cache(directory.string());
+
+	L1RoutingGraph rgraph;
+	rgraph.add(HICANNOnWafer());
+	cache.store(1, rgraph);
+
+	// Flip a bit in the last word, i.e. in the set of removed edges.
+	{
+		std::fstream file(cache.path(1), std::ios::binary | std::ios::in | std::ios::out);
+		file.seekg(-1, std::ios::end);
+		char const byte = static_cast<char>(file.get() ^ 0x1);
+		file.seekp(-1, std::ios::end);
+		file.put(byte);
+	}
+
+	L1RoutingGraph restored;
+	EXPECT_FALSE(cache.load(1, {HICANNOnWafer()}, restored));
+	EXPECT_EQ(0, num_vertices(restored.graph()));
+}
+
+TEST_F(L1RoutingGraphCacheTest, ignoresEntriesForOtherHICANNs)
+{
+	L1RoutingGraphCache cache(directory.string());
+
+	HICANNOnWafer const hicann(X(5), Y(5));
+	L1RoutingGraph rgraph;
+	rgraph.add(hicann);
+	rgraph.add(hicann.east());
+	cache.store(1, rgraph);
+
+	L1RoutingGraph restored;
+	EXPECT_FALSE(cache.load(1, {hicann}, restored));
+	EXPECT_FALSE(cache.load(1, {hicann.east(), hicann}, restored));
+	EXPECT_FALSE(cache.load(1, {hicann, hicann.south()}, restored));
+	EXPECT_EQ(0, num_vertices(restored.graph()));
+	EXPECT_TRUE(cache.load(1, {hicann, hicann.east()}, restored));
+}
+
+TEST_F(L1RoutingGraphCacheTest, refusesToLoadIntoNonEmptyGraph)
+{
+	L1RoutingGraphCache cache(directory.string());
+	L1RoutingGraph rgraph;
+	rgraph.add(HICANNOnWafer());
+	EXPECT_THROW(cache.load(1, {HICANNOnWafer()}, rgraph), std::invalid_argument);
+}
+
+} // namespace routing
+} // namespace marocco
@@ -0,0 +1,152 @@
+#include "test/common.h"
+
+#include <map>
+#include <set>
+
+#include "halco/hicann/v2/hicann.h"
+#include "halco/common/iter_all.h"
+#include "marocco/routing/L1DijkstraRouter.h"
+#include "marocco/routing/L1SteinerRouter.h"
+
+using namespace halco::hicann::v2;
+using namespace halco::common;
+
+namespace marocco {
+namespace routing {
+
+class AL1SteinerRouter : public ::testing::Test
+{
+protected:
+	static void SetUpTestCase()
+	{
+		for (auto hicann : iter_all<HICANNOnWafer>()) {
+			routing_graph.add(hicann);
+		}
+	}
+
+	static std::vector<Target> fan_out()
+	{
+		std::vector<Target> targets;
+		for (size_t yy = 3; yy <= 9; yy += 2) {
+			for (size_t xx = 12; xx <= 18; xx += 3) {
+				targets.push_back(Target(HICANNOnWafer(X(xx), Y(yy)), vertical));
+			}
+		}
+		return targets;
+	}
+
+	static L1RoutingGraph routing_graph;
+}; // AL1SteinerRouter
+
+L1RoutingGraph AL1SteinerRouter::routing_graph;
+
+TEST_F(AL1SteinerRouter, reachesAllTargets)
+{
+	HICANNOnWafer hicann(X(5), Y(5));
+	L1EdgeWeights weights(routing_graph.graph());
+	auto const source = routing_graph[hicann][SendingRepeaterOnHICANN(3).toHLineOnHICANN()];
+	L1SteinerRouter steiner(weights, source);
+	auto const targets = fan_out();
+	for (auto const& target : targets) {
+		steiner.add_target(target);
+	}
+	steiner.run();
+
+	auto const& graph = routing_graph.graph();
+	for (auto const& target : targets) {
+		auto const path = steiner.path_to(target);
+		ASSERT_FALSE(path.empty());
+		EXPECT_EQ(source, path.front());
+		EXPECT_EQ(target.toHICANNOnWafer(), graph[path.back()].toHICANNOnWafer());
+		EXPECT_TRUE(graph[path.back()].is_vertical());
+	}
+	EXPECT_EQ(targets.size(), steiner.tree().size());
+}
+
+TEST_F(AL1SteinerRouter, usesAtMostAsManyBusesAsShortestPaths)
+{
+	HICANNOnWafer hicann(X(5), Y(5));
+	L1EdgeWeights weights(routing_graph.graph());
+	auto const source = routing_graph[hicann][SendingRepeaterOnHICANN(3).toHLineOnHICANN()];
+	auto const targets = fan_out();
+
+	L1SteinerRouter steiner(weights, source);
+	for (auto const& target : targets) {
+		steiner.add_target(target);
+	}
+	steiner.run();
+
+	std::set<L1RoutingGraph::vertex_descriptor> steiner_buses, dijkstra_buses;
+	for (auto const& target : targets) {
+		auto const path = steiner.path_to(target);
+		steiner_buses.insert(path.begin(), path.end());
+
+		L1DijkstraRouter dijkstra(weights, source);
+		dijkstra.add_target(target);
+		dijkstra.run();
+		auto const& vertices = dijkstra.vertices_for(target);
+		ASSERT_FALSE(vertices.empty());
+		auto const other = dijkstra.path_to(*vertices.begin());
+		dijkstra_buses.insert(other.begin(), other.end());
+	}
+	EXPECT_LE(steiner_buses.size(), dijkstra_buses.size());
+}
+
+TEST_F(AL1SteinerRouter, respectsSwitchLimit)
+{
+	HICANNOnWafer hicann(X(5), Y(5));
+	L1EdgeWeights weights(routing_graph.graph());
+	auto const source = routing_graph[hicann][SendingRepeaterOnHICANN(3).toHLineOnHICANN()];
+	auto const targets = fan_out();
+	auto const& graph = routing_graph.graph();
+
+	for (size_t limit : {1, 2}) {
+		L1SteinerRouter steiner(
+		    weights, source, [limit](L1RoutingGraph::vertex_descriptor) { return limit; });
+		for (auto const& target : targets) {
+			steiner.add_target(target);
+		}
+		steiner.run();
+
+		std::set<std::pair<L1RoutingGraph::vertex_descriptor, L1RoutingGraph::vertex_descriptor> >
+		    switches;
+		for (auto const& target : targets) {
+			auto const path = steiner.path_to(target);
+			ASSERT_FALSE(path.empty());
+			for (size_t ii = 1; ii < path.size(); ++ii) {
+				if (graph[path[ii - 1]].is_vertical() != graph[path[ii]].is_vertical()) {
+					switches.insert(std::minmax(path[ii - 1], path[ii]));
+				}
+			}
+		}
+
+		std::map<L1RoutingGraph::vertex_descriptor, size_t> per_bus;
+		for (auto const& item : switches) {
+			++per_bus[item.first];
+			++per_bus[item.second];
+		}
+		for (auto const& item : per_bus) {
+			EXPECT_LE(item.second, limit);
+		}
+	}
+}
+
+TEST_F(AL1SteinerRouter, returnsEmptyPathForUnreachableTargets)
+{
+	HICANNOnWafer hicann(X(5), Y(5));
+	L1EdgeWeights weights(routing_graph.graph());
+	auto const source = routing_graph[hicann][SendingRepeaterOnHICANN(3).toHLineOnHICANN()];
+	L1SteinerRouter steiner(weights, source, [](L1RoutingGraph::vertex_descriptor) {
+		return size_t(0);
+	});
+	Target const target(HICANNOnWafer(X(12), Y(9)), vertical);
+	steiner.add_target(target);
+	steiner.run();
+
+	EXPECT_TRUE(steiner.path_to(target).empty());
+	EXPECT_THROW(
+	    steiner.path_to(Target(HICANNOnWafer(X(13), Y(9)), vertical)), std::runtime_error);
+}
+
+} // namespace routing
+} // namespace marocco
@@ -0,0 +1,46 @@
+#include "test/common.h"
+
+#include "marocco/routing/PathBundle.h"
+#include "marocco/routing/RoutingWorkspace.h"
+
+namespace marocco {
+namespace routing {
+
+TEST(RoutingWorkspace, defaultsToUnsetEntries)
+{
+	RoutingWorkspace workspace;
+	workspace.reset(10);
+	EXPECT_EQ(10, workspace.size());
+	for (size_t vertex = 0; vertex < workspace.size(); ++vertex) {
+		EXPECT_EQ(vertex, workspace.predecessor(vertex));
+		EXPECT_EQ(RoutingWorkspace::infinite_distance(), workspace.distance(vertex));
+		EXPECT_FALSE(workspace.is_finished(vertex));
+	}
+}
+
+TEST(RoutingWorkspace, storesEntriesUntilReset)
+{
+	RoutingWorkspace workspace;
+	workspace.reset(10);
+	workspace.set_predecessor(3, 2);
+	workspace.set_predecessor(2, 1);
+	workspace.set_distance(3, 42);
+	workspace.set_finished(2);
+
+	EXPECT_EQ(2, workspace.predecessor(3));
+	EXPECT_EQ(42, workspace.distance(3));
+	EXPECT_TRUE(workspace.is_finished(2));
+	EXPECT_FALSE(workspace.is_finished(3));
+	EXPECT_EQ(RoutingWorkspace::infinite_distance(), workspace.distance(2));
+	EXPECT_EQ((PathBundle::path_type{1, 2, 3}), path_from_predecessors(workspace, 3));
+
+	workspace.reset(20);
+	EXPECT_EQ(20, workspace.size());
+	EXPECT_EQ(3, workspace.predecessor(3));
+	EXPECT_EQ(RoutingWorkspace::infinite_distance(), workspace.distance(3));
+	EXPECT_FALSE(workspace.is_finished(2));
+	EXPECT_EQ(PathBundle::path_type{3}, path_from_predecessors(workspace, 3));
+}
+
+} // namespace routing
+} // namespace marocco
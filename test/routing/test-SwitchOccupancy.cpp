@@ -0,0 +1,62 @@
+#include "test/common.h"
+
+#include "halco/hicann/v2/hicann.h"
+#include "marocco/routing/SwitchOccupancy.h"
+
+using namespace halco::hicann::v2;
+using namespace halco::common;
+
+namespace marocco {
+namespace routing {
+
+class ASwitchOccupancy : public ::testing::Test
+{
+protected:
+	ASwitchOccupancy()
+	{
+		routing_graph.add(hicann);
+		routing_graph.add(hicann.east());
+		occupancy.reset(boost::num_vertices(routing_graph.graph()));
+	}
+
+	HICANNOnWafer const hicann{X(5), Y(5)};
+	L1RoutingGraph routing_graph;
+	SwitchOccupancy occupancy;
+}; // ASwitchOccupancy
+
+TEST_F(ASwitchOccupancy, allowsOneSwitchPerBus)
+{
+	auto const hline = routing_graph[hicann][HLineOnHICANN(0)];
+	auto const vline = routing_graph[hicann][VLineOnHICANN(0)];
+	auto const other_vline = routing_graph[hicann][VLineOnHICANN(32)];
+	auto const other_hline = routing_graph[hicann.east()][HLineOnHICANN(0)];
+
+	EXPECT_FALSE(occupancy.is_used(hline));
+	EXPECT_TRUE(occupancy.use(hline, vline));
+	EXPECT_TRUE(occupancy.is_used(hline));
+	EXPECT_TRUE(occupancy.is_used(vline));
+
+	EXPECT_FALSE(occupancy.use(hline, other_vline));
+	// Nothing is changed for rejected switches.
+	EXPECT_FALSE(occupancy.is_used(other_vline));
+	EXPECT_FALSE(occupancy.is_used(other_hline));
+
+	occupancy.release(hline, vline);
+	EXPECT_FALSE(occupancy.is_used(hline));
+	EXPECT_TRUE(occupancy.use(hline, other_vline));
+}
+
+TEST_F(ASwitchOccupancy, canBeReset)
+{
+	auto const hline = routing_graph[hicann.east()][HLineOnHICANN(3)];
+	auto const vline = routing_graph[hicann.east()][VLineOnHICANN(128)];
+	EXPECT_TRUE(occupancy.use(hline, vline));
+
+	occupancy.reset(boost::num_vertices(routing_graph.graph()));
+	EXPECT_FALSE(occupancy.is_used(hline));
+	EXPECT_FALSE(occupancy.is_used(vline));
+	EXPECT_TRUE(occupancy.use(hline, vline));
+}
+
+} // namespace routing
+} // namespace marocco
@@ -5,8 +5,17 @@
 #include <fstream>
 #include <numeric>
 #include <boost/archive/text_iarchive.hpp>
+#include <boost/make_shared.hpp>
 #include <boost/serialization/unordered_map.h>
 
+#include "euter/fixedprobabilityconnector.h"
+#include "euter/nativerandomgenerator.h"
+#include "euter/objectstore.h"
+#include "euter/population.h"
+#include "euter/projection.h"
+#include "euter/synapses.h"
+#include "marocco/BioGraph.h"
+
 using namespace halco::hicann::v2;
 using namespace halco::common;
 using HMF::HICANN::DriverDecoder;
@@ -436,6 +445,150 @@ TEST(SynapseDriverRequirements, _calc)
 	ASSERT_EQ(5, num_synapses);
 }
 
+TEST(SynapseCounts, AddsPrecomputedCounts)
+{
+	SynapseCounts single;
+	for (size_t ii = 0; ii < 3; ++ii) {
+		single.add(NeuronOnHICANN(Enum(4)), L1Address(17), SynapseType::inhibitory, STPMode::off);
+	}
+	single.add(NeuronOnHICANN(Enum(4)), L1Address(2), SynapseType::inhibitory, STPMode::off);
+
+	SynapseCounts bulk;
+	bulk.add(
+		NeuronOnHICANN(Enum(4)),
+		Type_Decoder_STP(
+			SynapseType::inhibitory, L1Address(17).getDriverDecoderMask(), STPMode::off),
+		3);
+	bulk.add(
+		NeuronOnHICANN(Enum(4)),
+		Type_Decoder_STP(
+			SynapseType::inhibitory, L1Address(2).getDriverDecoderMask(), STPMode::off),
+		1);
+
+	ASSERT_EQ(single.get_counts(), bulk.get_counts());
+}
+
+class ASynapseDriverRequirements : public ::testing::Test
+{
+protected:
+	typedef NeuronOnNeuronBlock N;
+
+	ASynapseDriverRequirements() : source_hicann(Enum(42)), target_hicann(Enum(43))
+	{
+		using namespace euter;
+
+		auto const source = Population::create(os, 12, CellType::IF_cond_exp);
+		auto const target = Population::create(os, 8, CellType::IF_cond_exp);
+		auto const other_target = Population::create(os, 4, CellType::IF_cond_exp);
+
+		auto const rng = boost::make_shared<NativeRandomGenerator>();
+		auto const depression = boost::make_shared<SynapseDynamics>(
+		    boost::make_shared<TsodyksMarkramMechanism>(0.5, 100., 0.));
+		auto const facilitation = boost::make_shared<SynapseDynamics>(
+		    boost::make_shared<TsodyksMarkramMechanism>(0.5, 0., 100.));
+
+		// Projections with all combinations of synapse type and STP mode, as well as
+		// parallel projections between the same populations.
+		auto connect = [this, &rng](
+		    PopulationPtr const& pre, PopulationPtr const& post, std::string const& type,
+		    boost::shared_ptr<SynapseDynamics> const& dynamics) {
+			auto const con = boost::make_shared<FixedProbabilityConnector>(0.6, true, 1.);
+			Projection::create(os, pre, post, con, rng, "", type, dynamics);
+		};
+		connect(source, target, "excitatory", {});
+		connect(source, target, "inhibitory", depression);
+		connect(source, target, "excitatory", facilitation);
+		connect(source, other_target, "inhibitory", {});
+		connect(source, other_target, "excitatory", depression);
+		connect(target, other_target, "excitatory", {});
+
+		bio_graph.load(os);
+
+		// Sources are distributed over several mergers with different driver decoders.
+		for (size_t ii = 0; ii < source->size(); ++ii) {
+			LogicalNeuron const logical_neuron =
+			    LogicalNeuron::on(NeuronBlockOnWafer(NeuronBlockOnHICANN(0), source_hicann))
+			        .add(N(X(ii), Y(0)), 1)
+			        .done();
+			placement.add(BioNeuron(bio_graph[source.get()], ii), logical_neuron);
+			placement.set_address(
+			    logical_neuron,
+			    L1AddressOnWafer(
+			        DNCMergerOnWafer(DNCMergerOnHICANN(ii % 3), source_hicann),
+			        L1Address((ii * 13) % 64)));
+		}
+
+		// Targets of different sizes, the first population also sends via a merger of
+		// the target HICANN.
+		for (size_t ii = 0; ii < target->size(); ++ii) {
+			LogicalNeuron const logical_neuron =
+			    LogicalNeuron::on(NeuronBlockOnWafer(NeuronBlockOnHICANN(0), target_hicann))
+			        .add(N(X(2 * ii), Y(0)), 2)
+			        .add(N(X(2 * ii), Y(1)), 2)
+			        .done();
+			placement.add(BioNeuron(bio_graph[target.get()], ii), logical_neuron);
+			placement.set_address(
+			    logical_neuron,
+			    L1AddressOnWafer(
+			        DNCMergerOnWafer(DNCMergerOnHICANN(0), target_hicann), L1Address(ii)));
+		}
+		for (size_t ii = 0; ii < other_target->size(); ++ii) {
+			LogicalNeuron const logical_neuron =
+			    LogicalNeuron::on(NeuronBlockOnWafer(NeuronBlockOnHICANN(1), target_hicann))
+			        .add(N(X(ii), Y(0)), 1)
+			        .add(N(X(ii), Y(1)), 1)
+			        .done();
+			placement.add(BioNeuron(bio_graph[other_target.get()], ii), logical_neuron);
+		}
+
+		for (auto nrn : iter_all<NeuronOnHICANN>()) {
+			synaptic_inputs[nrn][halco::common::left] = SynapseType::excitatory;
+			synaptic_inputs[nrn][halco::common::right] = SynapseType::inhibitory;
+		}
+	}
+
+	euter::ObjectStore os;
+	BioGraph bio_graph;
+	HICANNOnWafer const source_hicann;
+	HICANNOnWafer const target_hicann;
+	placement::results::Placement placement;
+	results::SynapticInputs synaptic_inputs;
+};
+
+TEST_F(ASynapseDriverRequirements, countsSynapsesOfAllSourcesLikeSingleSources)
+{
+	SynapseDriverRequirements const requirements(target_hicann, placement, synaptic_inputs);
+	auto const counts = requirements.count_synapses(bio_graph);
+
+	std::vector<DNCMergerOnWafer> mergers;
+	for (size_t ii = 0; ii < 3; ++ii) {
+		mergers.push_back(DNCMergerOnWafer(DNCMergerOnHICANN(ii), source_hicann));
+	}
+	mergers.push_back(DNCMergerOnWafer(DNCMergerOnHICANN(0), target_hicann));
+	// Merger without any sources.
+	mergers.push_back(DNCMergerOnWafer(DNCMergerOnHICANN(5), source_hicann));
+	EXPECT_EQ(mergers.size() - 1, counts.size());
+
+	SynapseCounts const no_synapses;
+	for (auto const& merger : mergers) {
+		std::map<Side_Parity_Decoder_STP, size_t> expected_synapses;
+		std::map<Side_Parity_Decoder_STP, size_t> expected_synrows;
+		auto const expected = requirements.calc(
+		    merger, bio_graph.graph(), expected_synapses, expected_synrows);
+
+		auto const it = counts.find(merger);
+		std::map<Side_Parity_Decoder_STP, size_t> synapses;
+		std::map<Side_Parity_Decoder_STP, size_t> synrows;
+		auto const result = requirements.calc(
+		    it == counts.end() ? no_synapses : it->second, synapses, synrows);
+
+		EXPECT_EQ(expected, result) << merger;
+		EXPECT_EQ(expected_synapses, synapses) << merger;
+		EXPECT_EQ(expected_synrows, synrows) << merger;
+		EXPECT_EQ(it != counts.end(), expected.second > 0) << merger;
+	}
+}
+
 TEST(SynapseDriverRequirements, count_synapses_per_hardware_property)
 {
 	// Test with failing assertion in systemsim-test test hardware neuron size of 6 and 10, etc..
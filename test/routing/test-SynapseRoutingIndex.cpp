@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+
+#include "halco/hicann/v2/fwd.h"
+#include "marocco/routing/SynapseRoutingIndex.h"
+
+using namespace halco::hicann::v2;
+using namespace halco::common;
+
+namespace marocco {
+namespace routing {
+
+class ASynapseRoutingIndex : public ::testing::Test
+{
+protected:
+	typedef NeuronOnNeuronBlock N;
+
+	ASynapseRoutingIndex()
+		: hicann(Enum(42)),
+		  other_hicann(Enum(43)),
+		  merger(DNCMergerOnHICANN(3), hicann)
+	{
+		// Population 0 spans both HICANNs, population 1 only the first one.
+		for (size_t ii = 0; ii < 4; ++ii) {
+			auto const& target = ii < 2 ? hicann : other_hicann;
+			LogicalNeuron const logical_neuron =
+			    LogicalNeuron::on(NeuronBlockOnWafer(NeuronBlockOnHICANN(0), target))
+			        .add(N(X(ii), Y(0)), 1)
+			        .done();
+			placement.add(BioNeuron(0, ii), logical_neuron);
+		}
+		LogicalNeuron const logical_neuron =
+		    LogicalNeuron::on(NeuronBlockOnWafer(NeuronBlockOnHICANN(1), hicann))
+		        .add(N(X(0), Y(0)), 1)
+		        .done();
+		placement.add(BioNeuron(1, 0), logical_neuron);
+		placement.set_address(
+		    logical_neuron, L1AddressOnWafer(merger, HMF::HICANN::L1Address(5)));
+
+		// External source.
+		LogicalNeuron const external = LogicalNeuron::external(2, 0);
+		placement.add(BioNeuron(2, 0), external);
+		placement.set_address(external, L1AddressOnWafer(merger, HMF::HICANN::L1Address(6)));
+	}
+
+	HICANNOnWafer const hicann;
+	HICANNOnWafer const other_hicann;
+	DNCMergerOnWafer const merger;
+	placement::results::Placement placement;
+};
+
+TEST_F(ASynapseRoutingIndex, groupsTargetsByHICANNAndPopulation)
+{
+	SynapseRoutingIndex const index(placement);
+
+	auto const& targets = index.targets(hicann, 0);
+	ASSERT_EQ(2, targets.size());
+	for (auto const* item : targets) {
+		EXPECT_EQ(0, item->population());
+		EXPECT_EQ(hicann, item->neuron_block()->toHICANNOnWafer());
+	}
+	EXPECT_EQ(2, index.targets(other_hicann, 0).size());
+	EXPECT_EQ(1, index.targets(hicann, 1).size());
+	EXPECT_TRUE(index.targets(other_hicann, 1).empty());
+
+	// External neurons are never targets.
+	EXPECT_TRUE(index.targets(hicann, 2).empty());
+	EXPECT_TRUE(index.targets(HICANNOnWafer(Enum(0)), 0).empty());
+}
+
+TEST_F(ASynapseRoutingIndex, groupsSourcesByDNCMergerAndPopulation)
+{
+	SynapseRoutingIndex const index(placement);
+
+	EXPECT_TRUE(index.sources(merger, 0).empty());
+	ASSERT_EQ(1, index.sources(merger, 1).size());
+	EXPECT_EQ(BioNeuron(1, 0), index.sources(merger, 1).front()->bio_neuron());
+	ASSERT_EQ(1, index.sources(merger, 2).size());
+	EXPECT_EQ(BioNeuron(2, 0), index.sources(merger, 2).front()->bio_neuron());
+
+	EXPECT_TRUE(index.sources(DNCMergerOnWafer(DNCMergerOnHICANN(2), hicann), 1).empty());
+}
+
+} // namespace routing
+} // namespace marocco
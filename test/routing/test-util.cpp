@@ -1,6 +1,7 @@
 #include "test/common.h"
 
 #include <bitset>
+#include <vector>
 #include <boost/dynamic_bitset.hpp>
 
 #include "marocco/routing/util.h"
@@ -35,5 +36,57 @@ TEST(Routing, relative_index)
 	EXPECT_EQ(0, to_relative_index(mask_2,3));
 }
 
+namespace {
+
+/// Minimal graph with projection-view-like edge properties.
+struct MaskGraph
+{
+	typedef size_t edge_descriptor;
+
+	struct View
+	{
+		struct Population
+		{
+			boost::dynamic_bitset<> const& mask() const { return m_mask; }
+			boost::dynamic_bitset<> m_mask;
+		};
+
+		Population const& pre() const { return m_pre; }
+		Population const& post() const { return m_post; }
+		Population m_pre;
+		Population m_post;
+	};
+
+	View const& operator[](edge_descriptor edge) const { return views.at(edge); }
+	std::vector<View> views;
+};
+
+} // namespace
+
+TEST(Routing, RelativeIndexCache)
+{
+	MaskGraph graph;
+	graph.views.resize(2);
+	graph.views[0].m_pre.m_mask = boost::dynamic_bitset<>(std::string("0110"));
+	graph.views[0].m_post.m_mask = boost::dynamic_bitset<>(std::string("1001"));
+	graph.views[1].m_pre.m_mask = boost::dynamic_bitset<>(std::string("1111"));
+	graph.views[1].m_post.m_mask = boost::dynamic_bitset<>(std::string("0001"));
+
+	RelativeIndexCache<MaskGraph> cache;
+	auto const& first = cache.get(graph, 0);
+	EXPECT_EQ(1, to_relative_index(first.pre, 2));
+	EXPECT_EQ(1, to_relative_index(first.post, 3));
+	EXPECT_EQ(3, from_relative_index(first.post, 1));
+	EXPECT_ANY_THROW(to_relative_index(first.post, 1));
+
+	auto const& second = cache.get(graph, 1);
+	EXPECT_EQ(3, to_relative_index(second.pre, 3));
+	EXPECT_EQ(0, to_relative_index(second.post, 0));
+
+	// Items are only built once and stay valid.
+	EXPECT_EQ(&first, &cache.get(graph, 0));
+	EXPECT_EQ(to_relative_index(graph.views[0].m_pre.mask(), 2), to_relative_index(first.pre, 2));
+}
+
 } // routing
 } // marocco
@@ -0,0 +1,123 @@
+#include "test/common.h"
+#include "euter/objectstore.h"
+#include "euter/population_view.h"
+#include "euter/projection_view.h"
+#include "euter/fixedprobabilityconnector.h"
+#include "euter/nativerandomgenerator.h"
+#include <boost/make_shared.hpp>
+#include <cmath>
+#include <vector>
+
+#include "marocco/ProjectionConnectivity.h"
+
+using namespace euter;
+
+namespace marocco {
+
+class AProjectionConnectivity : public ::testing::Test
+{
+protected:
+	typedef boost::dynamic_bitset<> mask_type;
+
+	// pre: neurons 1, 2, 4 of 5, post: neurons 0, 2, 3 of 4
+	AProjectionConnectivity()
+		: pre(Population::create(os, 5, CellType::IF_cond_exp)),
+		  post(Population::create(os, 4, CellType::IF_cond_exp))
+	{
+		PopulationView const pre_view(pre, mask_type(5, 0x16));
+		PopulationView const post_view(post, mask_type(4, 0xd));
+
+		auto con = boost::make_shared<FixedProbabilityConnector>(1, true, 1.);
+		auto rng = boost::make_shared<NativeRandomGenerator>();
+		proj = Projection::create(os, pre_view, post_view, con, rng);
+
+		// Only keep (0, 1), (0, 2), (2, 0), zero, negative and nan weights are not
+		// considered to be realized.
+		auto& weights = proj->getWeights().get();
+		for (size_t ii = 0; ii < weights.size1(); ++ii) {
+			for (size_t jj = 0; jj < weights.size2(); ++jj) {
+				weights(ii, jj) = 0.;
+			}
+		}
+		weights(0, 1) = 1.;
+		weights(0, 2) = 2.;
+		weights(1, 0) = -1.;
+		weights(1, 1) = std::nan("");
+		weights(2, 0) = 3.;
+	}
+
+	ProjectionView view() const
+	{
+		return proj->flatten().front();
+	}
+
+	ObjectStore os;
+	PopulationPtr pre;
+	PopulationPtr post;
+	ProjectionPtr proj;
+};
+
+TEST_F(AProjectionConnectivity, onlyStoresRealizedConnections)
+{
+	ProjectionConnectivity const connectivity(view());
+
+	ASSERT_EQ(3, connectivity.size1());
+	ASSERT_EQ(3, connectivity.size2());
+	EXPECT_EQ(3, connectivity.nnz());
+
+	EXPECT_EQ(2, connectivity.row_nnz(0));
+	EXPECT_EQ(0, connectivity.row_nnz(1));
+	EXPECT_EQ(1, connectivity.row_nnz(2));
+	EXPECT_EQ(1, connectivity.column_nnz(0));
+	EXPECT_EQ(1, connectivity.column_nnz(1));
+	EXPECT_EQ(1, connectivity.column_nnz(2));
+}
+
+TEST_F(AProjectionConnectivity, iteratesRowsAndColumns)
+{
+	ProjectionConnectivity const connectivity(view());
+
+	auto const row = connectivity.row(0);
+	EXPECT_EQ(
+	    (std::vector<ProjectionConnectivity::index_type>{1, 2}),
+	    std::vector<ProjectionConnectivity::index_type>(row.begin(), row.end()));
+	EXPECT_TRUE(connectivity.row(1).empty());
+
+	auto const column = connectivity.column(0);
+	EXPECT_EQ(
+	    (std::vector<ProjectionConnectivity::index_type>{2}),
+	    std::vector<ProjectionConnectivity::index_type>(column.begin(), column.end()));
+
+	EXPECT_ANY_THROW(connectivity.row(3));
+	EXPECT_ANY_THROW(connectivity.column(3));
+}
+
+TEST_F(AProjectionConnectivity, mapsAbsoluteToRelativeIndices)
+{
+	ProjectionConnectivity const connectivity(view());
+
+	EXPECT_EQ(ProjectionConnectivity::invalid, connectivity.pre_index(0));
+	EXPECT_EQ(0, connectivity.pre_index(1));
+	EXPECT_EQ(1, connectivity.pre_index(2));
+	EXPECT_EQ(ProjectionConnectivity::invalid, connectivity.pre_index(3));
+	EXPECT_EQ(2, connectivity.pre_index(4));
+	EXPECT_EQ(ProjectionConnectivity::invalid, connectivity.pre_index(5));
+
+	EXPECT_EQ(0, connectivity.post_index(0));
+	EXPECT_EQ(ProjectionConnectivity::invalid, connectivity.post_index(1));
+	EXPECT_EQ(2, connectivity.post_index(3));
+
+	EXPECT_EQ(4, connectivity.pre_neuron(2));
+	EXPECT_EQ(3, connectivity.post_neuron(2));
+	EXPECT_ANY_THROW(connectivity.pre_neuron(3));
+}
+
+TEST(ProjectionConnectivity, canBeEmpty)
+{
+	ProjectionConnectivity const connectivity;
+	EXPECT_EQ(0, connectivity.size1());
+	EXPECT_EQ(0, connectivity.size2());
+	EXPECT_EQ(0, connectivity.nnz());
+}
+
+} // namespace marocco
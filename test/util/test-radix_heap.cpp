@@ -0,0 +1,64 @@
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "marocco/util/radix_heap.h"
+#include "test/common.h"
+
+namespace marocco {
+
+TEST(RadixHeap, ExtractsElementsInOrder)
+{
+	std::vector<size_t> keys{7, 3, 3, 0, 10000, 42, 1, 10001};
+	radix_heap<size_t, size_t> heap;
+	for (size_t ii = 0; ii < keys.size(); ++ii) {
+		heap.push(keys[ii], ii);
+	}
+	EXPECT_EQ(keys.size(), heap.size());
+
+	std::vector<size_t> extracted;
+	while (!heap.empty()) {
+		auto const& top = heap.top();
+		EXPECT_EQ(keys[top.second], top.first);
+		extracted.push_back(top.first);
+		heap.pop();
+	}
+
+	std::sort(keys.begin(), keys.end());
+	EXPECT_EQ(keys, extracted);
+}
+
+TEST(RadixHeap, SupportsInterleavedMonotonePushes)
+{
+	std::mt19937 random(1234);
+	std::uniform_int_distribution<size_t> increment(0, 20000);
+
+	radix_heap<size_t, size_t> heap;
+	heap.push(0, 0);
+	size_t last = 0;
+	for (size_t ii = 0; ii < 1000 && !heap.empty(); ++ii) {
+		auto const key = heap.top().first;
+		heap.pop();
+		ASSERT_LE(last, key);
+		last = key;
+		for (size_t jj = 0; jj < 2; ++jj) {
+			heap.push(key + increment(random), ii);
+		}
+	}
+}
+
+TEST(RadixHeap, RejectsKeysSmallerThanLastMinimum)
+{
+	radix_heap<size_t, size_t> heap;
+	heap.push(5, 0);
+	heap.top();
+	heap.pop();
+	EXPECT_THROW(heap.push(4, 0), std::invalid_argument);
+	EXPECT_NO_THROW(heap.push(5, 0));
+
+	heap.clear();
+	EXPECT_TRUE(heap.empty());
+	EXPECT_NO_THROW(heap.push(0, 0));
+}
+
+} // namespace marocco
@@ -0,0 +1,55 @@
+#include <random>
+#include <boost/dynamic_bitset.hpp>
+
+#include "marocco/util/rank_select.h"
+#include "test/common.h"
+
+namespace marocco {
+
+TEST(RankSelect, CanBeEmpty)
+{
+	rank_select const empty;
+	EXPECT_EQ(0, empty.size());
+	EXPECT_EQ(0, empty.count());
+	EXPECT_ANY_THROW(empty.rank(0));
+	EXPECT_ANY_THROW(empty.select(0));
+}
+
+TEST(RankSelect, MatchesLinearScan)
+{
+	std::mt19937 gen(1234);
+	// Cover partial, single and multiple words as well as narrow blocks.
+	for (size_t const size : {1, 7, 63, 64, 65, 200, 1000}) {
+		boost::dynamic_bitset<> mask(size);
+		boost::dynamic_bitset<unsigned char> narrow_mask(size);
+		for (size_t ii = 0; ii < size; ++ii) {
+			if (gen() % 3 == 0) {
+				mask.set(ii);
+				narrow_mask.set(ii);
+			}
+		}
+
+		rank_select const index(mask);
+		rank_select const narrow_index(narrow_mask);
+		ASSERT_EQ(size, index.size());
+		ASSERT_EQ(mask.count(), index.count());
+		ASSERT_EQ(mask.count(), narrow_index.count());
+
+		size_t rank = 0;
+		for (size_t ii = 0; ii < size; ++ii) {
+			ASSERT_EQ(mask.test(ii), index.test(ii));
+			ASSERT_EQ(rank, index.rank(ii));
+			ASSERT_EQ(rank, narrow_index.rank(ii));
+			if (mask.test(ii)) {
+				ASSERT_EQ(ii, index.select(rank));
+				ASSERT_EQ(ii, narrow_index.select(rank));
+				++rank;
+			}
+		}
+
+		EXPECT_ANY_THROW(index.rank(size));
+		EXPECT_ANY_THROW(index.select(rank));
+	}
+}
+
+} // namespace marocco
@@ -54,7 +54,9 @@ std::vector<L1Route> Alone::find_routes(
 	    weights, m_routing_graph[source],
 	    (options & SWITCH_EXCLUSIVENESS_PER_ROUTE)
 	        ? routing::L1DijkstraRouter::SwitchExclusiveness::per_route
-	        : routing::L1DijkstraRouter::SwitchExclusiveness::global);
+	        : routing::L1DijkstraRouter::SwitchExclusiveness::global,
+	    // All possible routes are requested, so the search must not stop early.
+	    routing::L1DijkstraRouter::Termination::exhaustive);
 	dijkstra.add_target(target);
 	dijkstra.run();
 	std::vector<L1Route> routes;